@@ -10,6 +10,8 @@
 
 #include <Arduino.h>
 
+#include "board_local.h"
+#include "input_engine.h"
 
 class DigitalPinIn {
 public:
@@ -18,6 +20,16 @@ public:
     bool isOff(void);
     bool hasChanged(void);
 
+    // Switch to debounced, interrupt driven input (see input_engine.h); false if no channel is free.
+    //   isOn() then never reads the pin, and wasTurnedOn() reports every press, however short.
+    bool useInterrupts(uint8_t debounceMillis, uint16_t longPressMillis);
+    // true once per off to on edge; polled inputs only see the edges between two calls
+    bool wasTurnedOn(void);
+    // true once per long press; interrupt driven inputs only
+    bool wasHeld(void);
+    // hand the engine's queued events to their inputs; once per tick, before the inputs are used
+    static void dispatchEvents(void);
+
 protected:
     int value(void);
     int _lastReadValue;
@@ -27,6 +39,15 @@ private:
     bool _highIsOn;
 
     bool _valueHasChanged;
+    bool _wasOn;         // polled edge detection
+    int8_t _channel;     // InputEngine channel, -1 when polled
+    uint8_t _turnedOn;   // edges dispatched but not yet taken by wasTurnedOn()
+    bool _held;
+
+    struct InterruptInputs {
+        DigitalPinIn *inputs[inputMaxChannels]; // by InputEngine channel
+    };
+    static BoardLocal<InterruptInputs> _interruptInputs;
 };
 
 class DigitalPinOut {
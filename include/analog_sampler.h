@@ -0,0 +1,48 @@
+/*
+    analog_sampler.h
+    2026-10-17
+
+    Interrupt driven analog inputs: oversampled, decimated and smoothed in the background
+
+    analogRead() starts a conversion and waits about 110us for it, and a single 10 bit reading of
+        a photoresistor or a potentiometer is noisy.  Instead, the ADC is auto-triggered by
+        Timer0's overflow (the millis() interrupt, once per 1.024ms), and its conversion complete
+        interrupt takes each result and switches the multiplexer to the next attached channel,
+        round robin.
+    Each channel sums analogOversample conversions and decimates them to one 12 bit sample,
+        which goes through a first order low pass filter (new = old + (sample - old) / 4).
+        With two channels a sample arrives every 33ms, and the filter's time constant is about 130ms.
+    value() and read() just return the filtered value, so they cost the main loop nothing.
+
+    begin() seeds each channel with one analogRead(), so the first reads are not zero.  While the
+        sampler runs, analogRead() of any other pin would fight it for the multiplexer; attach
+        every analog input instead.
+
+    Native build: rather than an interrupt every simulated millisecond, value() runs the
+        conversions the ADC would have made since it was last asked, and so does the simulated
+        board just before an analog input changes; inputs hold steady in between, so a settled
+        channel skips the rest of its blocks.
+*/
+
+#ifndef analog_sampler_h
+#define analog_sampler_h
+
+#include <Arduino.h>
+
+const uint8_t analogMaxChannels = 4;
+const uint8_t analogOversample = 16;   // conversions per sample; 16 adds two bits
+const uint16_t analogValueMax = 4092;  // 16 * 1023 / 4
+const unsigned long analogConversionMicros = 1024; // one per Timer0 overflow
+
+class AnalogSampler {
+public:
+  // returns the channel, or -1 if every channel is taken
+  static int8_t attach(uint8_t pin);
+  // seed the channels and start converting; call once, after the channels are attached
+  static void begin(void);
+
+  static uint16_t value(uint8_t channel); // 0 - analogValueMax
+  static int read(uint8_t channel);       // 0 - 1023, as analogRead()
+};
+
+#endif
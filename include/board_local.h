@@ -0,0 +1,49 @@
+/*
+    board_local.h
+    2026-10-17
+
+    State there is one of per microcontroller
+
+    The engines (input, analog sampling, tones, telemetry, the EEPROM journal, idle sleep) keep
+        their state in statics, since the Mega has one of each piece of hardware they drive.
+        A host program simulating several dwellings has a board for each (see sim_board.h),
+        and each board needs its own engines.
+    BoardLocal<T> is such a static.  On the AVR it is a plain T, so the engines compile to the
+        same direct loads and stores as before; on the host it is the T belonging to
+        SimBoard::active(), a thread local lookup per use.  Code that uses one several times
+        takes a reference first:
+            static BoardLocal<InputEngineState> engine;
+            InputEngineState &state = *engine;
+    Anything that touches a board's engines, the simulated interrupts included, runs with that
+        board active (SimBoard::Scope), on whatever thread.
+*/
+
+#ifndef board_local_h
+#define board_local_h
+
+#ifndef __AVR__
+#include "sim_board.h"
+#endif
+
+template <class T> class BoardLocal {
+public:
+#ifdef __AVR__
+  T &operator*(void) {
+    return _value;
+  }
+#else
+  T &operator*(void) {
+    return SimBoard::active().local<T>();
+  }
+#endif
+  T *operator->(void) {
+    return &**this;
+  }
+
+private:
+#ifdef __AVR__
+  T _value;
+#endif
+};
+
+#endif
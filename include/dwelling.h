@@ -14,6 +14,12 @@
             constructor while preserving the ability to move hardware around
             without having to change code in multiple places.
 
+    BasicDwelling<Config> takes its pins, thresholds, tick periods and component types from a
+        config (see dwelling_config.h); Dwelling is the panel as built.  All of a dwelling's
+        state is in its members, so the host programs can run several at once.  The hardware
+        engines (input, analog sampling, tones, telemetry, the journal) are one per board
+        (see board_local.h).
+
     As designed here (really just thoughts for now), the Dwelling is really the whole
         MVC enchilada: the components of the house (Model), the status displays (View),
         and the control board (Controller).
@@ -23,58 +29,109 @@
 #define DWELLING_H
 
 #include "DigitalPinIO.h"
+#include "dwelling_config.h"
+#include "fast_pin.h"
+#include "interrupt_keypad.h"
 #include "LiquidCrystal_I2C.h"
+#include "lcd_framebuffer.h"
 #include "led.h"
 #include "passive_buzzer.h"
 #include "photoresistor.h"
 #include "power.h"
+#include "scheduler.h"
 #include <Arduino.h>
 #include <Keypad.h>
 
-class Dwelling {
+// Steps of the PIN entry state machine run by Dwelling::unlock()
+typedef enum {
+  AccessPrompt = 0, // show the prompt and start a new code
+  AccessEntering,   // collecting keys
+  AccessGranted,    // "System Unlocked" on display
+  AccessBadCode,    // "Bad Code" on display
+  AccessLockedOut,  // too many failures, waiting out the delay
+  AccessUnlocked
+} AccessState;
+
+const uint8_t dwellingTaskCount = 10;
+
+template <class Config> class BasicDwelling {
 public:
   void init(void);
 
   // components
-  Buzzer _alarmSystem;
-  HouseBattery _electricalStorage;
-  DigitalPinOut _exteriorLights;
-  DimmableLED _interiorLights;
-  DigitalPinIn _intruderAlarm;
-  PhotoResistor _solarArray;
+  typename Config::AlarmSystem _alarmSystem;
+  BasicHouseBattery<Config> _electricalStorage;
+  typename Config::ExteriorLights _exteriorLights;
+  typename Config::InteriorLights _interiorLights;
+  typename Config::IntruderAlarm _intruderAlarm;
+  typename Config::SolarArray _solarArray;
 
   // Status Displays
-  RedGreenLED _batteryStatusLight;
-  DigitalPinOut _exteriorAlertLight;
+  typename Config::BatteryStatusLight _batteryStatusLight;
+  typename Config::ExteriorAlertLight _exteriorAlertLight;
   LiquidCrystal_I2C _statusDisplay;
+  LCDFrameBuffer _statusFrame; // all drawing goes here; update() sends only what changed
 
   // control board
-  DigitalPinIn _exteriorLightsButton;
-  DigitalPinIn _interiorLightsButton;
-  RedGreenLED _accessStatus;
-  Keypad _keypad; // from main.cpp
-
-  Dwelling(void);           // all pins, etc. are hard coded in constructor
-  void tick(int tickCount); // run every 1/10 second
-  void lighting(void);
-  void batteryChargingAndUsage(void);
-  void exteriorMotionDetector(int tickCount);
-  void statusDisplays(int tickCount);
+  typename Config::Button _exteriorLightsButton;
+  typename Config::Button _interiorLightsButton;
+  typename Config::AccessStatus _accessStatus;
+  typename Config::KeypadLayout _keypadWiring; // before _keypad, which keeps pointers into it
+  InterruptKeypad _keypad;                     // scanned only after a key wakes it
+
+  // scheduling: tick() runs the task table in dwelling.cpp
+  TaskScheduler<BasicDwelling, dwellingTaskCount> _scheduler;
+
+  BasicDwelling(void);      // all pins, etc. come from Config
+  void tick(TickCount tickCount); // run every 1/10 second
+  void lighting(TickCount tickCount);
+  void batteryChargingAndUsage(TickCount tickCount);
+  void exteriorMotionDetector(TickCount tickCount);
+  void statusDisplays(TickCount tickCount);
 
+  // one step of PIN entry, run every tick until unlocked; never blocks
   void unlock(void);
+  bool isUnlocked(void);
 
 private:
+  // strings in flash, F("..."), keep the Mega's SRAM free; the const char * forms are for strings built at run time
   void printToStatusDisplay(uint8_t x, uint8_t y, const char *string);
+  void printToStatusDisplay(uint8_t x, uint8_t y, const __FlashStringHelper *string);
   void printToStatusDisplay(uint8_t x, uint8_t y, int value);
   // prints a header and value to display.  Header starts at (x, y), printing clearString (which includes spaces to
   //   clear the space the value will occupy), then prints the value at (x+valueOffset, y)
   void printToStatusDisplay(uint8_t x, uint8_t y, uint8_t valueOffset, const char *clearString, int value);
+  void printToStatusDisplay(uint8_t x, uint8_t y, uint8_t valueOffset, const __FlashStringHelper *clearString,
+                            int value);
     // prints or clears (bool print) an "indicator" (single character) at (x, y)
   bool printIndicatorToStatusDisplay(uint8_t x, uint8_t y, bool print, const char indicator);
-  void houseBatteryStatusLight(int tickCount);
+  void houseBatteryStatusLight(TickCount tickCount);
+  void accessControl(TickCount tickCount);
+  void inputEvents(TickCount tickCount);
+  void statusDisplayStartup(TickCount tickCount);
+  void telemetry(TickCount tickCount);
+  void persistState(TickCount tickCount);
+  void journalState(bool now);
   void initStatusDisplay(void);
 
+  static const ScheduledTask<BasicDwelling> _tasks[dwellingTaskCount]; // PROGMEM
+
   bool _exteriorLightsTurnedOnManually;
+  void enterAccessState(AccessState state);
+  void enterCodeKey(char key);
+  void lockOut(void);
+
   bool _unlocked;
+  AccessState _accessState;
+  unsigned long _accessStateStarted; // millis()
+  uint8_t _codeCharsEntered;
+  bool _codeMatches;     // every key so far matched the code
+  uint8_t _unlockFailures; // kept across resets, failureLimit while locked out
 };
+
+typedef BasicDwelling<MegaPanel> Dwelling;
+#ifndef __AVR__
+typedef BasicDwelling<TunablePanel> TunableDwelling;
+#endif
+
 #endif
\ No newline at end of file
@@ -0,0 +1,129 @@
+/*
+    dwelling_config.h
+    2026-10-17
+
+    Compile time description of a panel, for BasicDwelling<Config> (see dwelling.h)
+
+    A config is a type with nothing but static constexpr members and typedefs:
+        pins, the LCD's I2C address and the keypad's wiring
+        the power model: HouseBattery's thresholds and charge rate, the lights' loads, the
+            interior dimmer levels
+        tick periods and phases for the scheduled tasks, input debounce
+        component types, which is where a pin becomes a template argument (FastPinOut etc.)
+    Every value reaches the code as a constant, so the AVR build gets the same immediates and
+        single instruction pin accesses as when they were written out in dwelling.cpp.
+        A different panel, or a host program trying other thresholds, is another config; it
+        needs an explicit instantiation next to MegaPanel's at the end of dwelling.cpp and
+        power.cpp.
+
+    MegaPanel is the panel as built, wired as in pins.h.
+    TunablePanel (host only) is MegaPanel with the power model in thread local variables, for
+        the parameter sweep (src/native/sweep.cpp): a thread sets them, then builds and runs its
+        dwelling.  Only values used as plain numbers can be made variable this way; pins, tick
+        periods and component types stay constant.
+*/
+
+#ifndef dwelling_config_h
+#define dwelling_config_h
+
+#include <Arduino.h>
+
+#include "DigitalPinIO.h"
+#include "fast_pin.h"
+#include "fixed_percent.h"
+#include "led.h"
+#include "passive_buzzer.h"
+#include "photoresistor.h"
+#include "pins.h"
+
+// Keypad reads its keymap from RAM on every scan, so each dwelling keeps a copy of this as a member
+template <uint8_t rows, uint8_t columns> struct KeypadWiring {
+  static constexpr uint8_t rowCount = rows;
+  static constexpr uint8_t columnCount = columns;
+
+  char keys[rows * columns]; // row by row
+  byte rowPins[rows];
+  byte columnPins[columns];
+};
+
+struct MegaPanel {
+  // pins
+  static constexpr uint8_t solarArrayAnalogInputPin = ::solarArrayAnalogInputPin;
+  static constexpr uint8_t interiorLightsPWMControlPin = ::interiorLightsPWMControlPin;
+  static constexpr uint8_t alarmSystemPWMPin = ::alarmSystemPWMPin;
+  static constexpr uint8_t lockGreenPin = ::lockGreenPin;
+  static constexpr uint8_t lockRedPin = ::lockRedPin;
+  static constexpr uint8_t interiorLightsButtonPin = ::interiorLightsButtonPin;
+  static constexpr uint8_t batteryLevelLEDRedPin = ::batteryLevelLEDRedPin;
+  static constexpr uint8_t batteryLevelLEDGreenPin = ::batteryLevelLEDGreenPin;
+  static constexpr uint8_t intruderMotionAlarmPin = ::intruderMotionAlarmPin;
+  static constexpr uint8_t exteriorLightsButtonPin = ::exteriorLightsButtonPin;
+  static constexpr uint8_t exteriorAlertLightPin = ::exteriorAlertLightPin;
+  static constexpr uint8_t exteriorFloodlightsPin = ::exteriorFloodlightsPin;
+  static constexpr uint8_t statusDisplayAddress = 0x27;
+
+  typedef KeypadWiring<4, 4> KeypadLayout;
+  static constexpr KeypadLayout keypad = {
+      {'1', '2', '3', 'A', '4', '5', '6', 'B', '7', '8', '9', 'C', '*', '0', '#', 'D'},
+      {keypad00, keypad01, keypad02, keypad03},
+      {keypad04, keypad05, keypad06, keypad07},
+  };
+
+  // HouseBattery
+  static constexpr FixedPercent maximumBatteryPower = fixedPercent(100);
+  static constexpr FixedPercent chargingThreshold = fixedPercent(90);
+  static constexpr FixedPercent prettyFullThreshold = fixedPercent(80);
+  static constexpr FixedPercent lowThreshold = fixedPercent(25);
+  static constexpr FixedPercent criticalThreshold = fixedPercent(10);
+  static constexpr uint8_t solarChargeDivisor = 50; // a charging step adds solar / 50
+
+  // loads, per charging step
+  static constexpr FixedPercent interiorLightsPowerUsage = fixedPercent(1);
+  static constexpr FixedPercent exteriorLightsPowerUsage = fixedPercent(3);
+
+  // interiorLights levels
+  static constexpr int interiorLightsCritical = 2;
+  static constexpr int interiorLightsLow = 63;
+  static constexpr int interiorLightsNormal = 255;
+
+  // ticks
+  static constexpr uint8_t chargingPeriodTicks = 10;
+  static constexpr uint8_t chargingPhaseTick = 0;
+  static constexpr uint8_t displayPeriodTicks = 2;
+  static constexpr uint8_t displayPhaseTick = 1; // off the charging ticks
+  static constexpr int batteryBlinkTicks = 5;
+
+  // input debounce; the buttons have no long press action yet
+  static constexpr uint8_t buttonDebounceMillis = 20;
+  static constexpr uint8_t motionDebounceMillis = 5;
+
+  // components
+  typedef Buzzer AlarmSystem;
+  typedef FastPinOut<exteriorFloodlightsPin> ExteriorLights;
+  typedef DimmableLED InteriorLights;
+  typedef DigitalPinIn IntruderAlarm;
+  typedef PhotoResistor SolarArray;
+  typedef FastRedGreenLED<batteryLevelLEDRedPin, batteryLevelLEDGreenPin> BatteryStatusLight;
+  typedef FastPinOut<exteriorAlertLightPin> ExteriorAlertLight;
+  typedef DigitalPinIn Button;
+  typedef FastRedGreenLED<lockRedPin, lockGreenPin> AccessStatus;
+};
+
+// HouseBattery adds a charging step in int, 16 bits on the AVR
+static_assert(MegaPanel::maximumBatteryPower + fixedPercent(100) / MegaPanel::solarChargeDivisor <= 0x7FFF,
+              "a charging step can overflow");
+
+#ifndef __AVR__
+struct TunablePanel : MegaPanel {
+  // MegaPanel's values until a thread sets its own; the thresholds must keep their order
+  static thread_local FixedPercent chargingThreshold;
+  static thread_local FixedPercent prettyFullThreshold;
+  static thread_local FixedPercent lowThreshold;
+  static thread_local FixedPercent criticalThreshold;
+  static thread_local uint8_t solarChargeDivisor; // not 0
+  static thread_local FixedPercent interiorLightsPowerUsage;
+  static thread_local FixedPercent exteriorLightsPowerUsage;
+};
+#endif
+
+#endif
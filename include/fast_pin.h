@@ -0,0 +1,306 @@
+/*
+    fast_pin.h
+    2026-10-17
+
+    Compile time digital pins for the Mega
+
+    digitalWrite() and digitalRead() look the pin up in three flash tables, check for a PWM timer
+        to switch off, and turn interrupts off around the write: several dozen cycles each time.
+        When the pin is a template argument the port register and bit are known to the compiler,
+        and a write to ports A-G is a single SBI or CBI, a read a single SBIS/SBIC or IN.
+        Ports H-L are outside SBI/CBI's reach; their writes are a read-modify-write of the port,
+        done with interrupts off so an ISR writing the same port cannot be undone.
+
+    FastPinOut, FastPinIn (and FastLED, FastRedGreenLED in led.h) keep the interfaces of the
+        runtime classes, constructor included, so a member can change type without touching
+        Dwelling's initializer list.  The pin and polarity come from the template; the
+        constructor arguments are accepted and ignored.
+    FastPinGroup<pins...> writes several pins of one port with a single store, so they change
+        together: no glitch between, say, a bicolor LED's red going off and its green coming on.
+    FastPinIn is the polled input; inputs handed to the input engine stay DigitalPinIn, since
+        the engine's interrupts already read them by port and mask.
+
+    The native build has no port registers, so there the same templates call digitalWrite() and
+        friends on the simulated board.
+*/
+
+#ifndef fast_pin_h
+#define fast_pin_h
+
+#include <Arduino.h>
+
+#include "DigitalPinIO.h"
+
+const uint8_t fastPinCount = 70; // Mega digital pins 0-53 plus A0-A15
+
+// port and bit of each Mega pin, as in the core's variants/mega/pins_arduino.h
+typedef enum {
+  FastPortA = 0,
+  FastPortB,
+  FastPortC,
+  FastPortD,
+  FastPortE,
+  FastPortF,
+  FastPortG,
+  FastPortH, // first port beyond SBI/CBI
+  FastPortJ,
+  FastPortK,
+  FastPortL
+} FastPort;
+
+constexpr uint8_t fastPinPorts[fastPinCount] = {
+    FastPortE, FastPortE, FastPortE, FastPortE, FastPortG, FastPortE, FastPortH, FastPortH, // 0-7
+    FastPortH, FastPortH, FastPortB, FastPortB, FastPortB, FastPortB, FastPortJ, FastPortJ, // 8-15
+    FastPortH, FastPortH, FastPortD, FastPortD, FastPortD, FastPortD, FastPortA, FastPortA, // 16-23
+    FastPortA, FastPortA, FastPortA, FastPortA, FastPortA, FastPortA, FastPortC, FastPortC, // 24-31
+    FastPortC, FastPortC, FastPortC, FastPortC, FastPortC, FastPortC, FastPortD, FastPortG, // 32-39
+    FastPortG, FastPortG, FastPortL, FastPortL, FastPortL, FastPortL, FastPortL, FastPortL, // 40-47
+    FastPortL, FastPortL, FastPortB, FastPortB, FastPortB, FastPortB, FastPortF, FastPortF, // 48-55
+    FastPortF, FastPortF, FastPortF, FastPortF, FastPortF, FastPortF, FastPortK, FastPortK, // 56-63
+    FastPortK, FastPortK, FastPortK, FastPortK, FastPortK, FastPortK,                       // 64-69
+};
+
+constexpr uint8_t fastPinBits[fastPinCount] = {
+    0, 1, 4, 5, 5, 3, 3, 4, // 0-7
+    5, 6, 4, 5, 6, 7, 1, 0, // 8-15
+    1, 0, 3, 2, 1, 0, 0, 1, // 16-23
+    2, 3, 4, 5, 6, 7, 7, 6, // 24-31
+    5, 4, 3, 2, 1, 0, 7, 2, // 32-39
+    1, 0, 7, 6, 5, 4, 3, 2, // 40-47
+    1, 0, 3, 2, 1, 0, 0, 1, // 48-55
+    2, 3, 4, 5, 6, 7, 0, 1, // 56-63
+    2, 3, 4, 5, 6, 7,       // 64-69
+};
+
+constexpr uint8_t fastFirstPin(uint8_t first) {
+  return first;
+}
+template <class... Rest> constexpr uint8_t fastFirstPin(uint8_t first, Rest...) {
+  return first;
+}
+
+// data space address of the port's PINx; DDRx and PORTx follow it
+constexpr uint16_t fastPortAddress(uint8_t port) {
+  return port < FastPortH ? 0x20 + 3 * port : 0x100 + 3 * (port - FastPortH);
+}
+
+template <uint8_t pin> class FastPinRegisters {
+public:
+  static_assert(pin < fastPinCount, "not a Mega pin");
+
+  static constexpr uint8_t mask = 1 << fastPinBits[pin];
+  static constexpr bool singleInstruction = fastPinPorts[pin] < FastPortH;
+
+#ifdef __AVR__
+  static volatile uint8_t &pinRegister(void) {
+    return *(volatile uint8_t *)fastPortAddress(fastPinPorts[pin]);
+  }
+  static volatile uint8_t &ddrRegister(void) {
+    return *(volatile uint8_t *)(fastPortAddress(fastPinPorts[pin]) + 1);
+  }
+  static volatile uint8_t &portRegister(void) {
+    return *(volatile uint8_t *)(fastPortAddress(fastPinPorts[pin]) + 2);
+  }
+
+  static void setBit(volatile uint8_t &reg, bool value) {
+    if (singleInstruction) {
+      if (value) {
+        reg |= mask;
+      }
+      else {
+        reg &= ~mask;
+      }
+    }
+    else {
+      uint8_t sreg = SREG;
+      cli();
+      if (value) {
+        reg |= mask;
+      }
+      else {
+        reg &= ~mask;
+      }
+      SREG = sreg;
+    }
+  }
+#endif
+
+  static void mode(uint8_t mode) {
+#ifdef __AVR__
+    setBit(ddrRegister(), mode == OUTPUT);
+    if (mode != OUTPUT) {
+      setBit(portRegister(), mode == INPUT_PULLUP);
+    }
+#else
+    pinMode(pin, mode);
+#endif
+  }
+
+  static void write(bool high) {
+#ifdef __AVR__
+    setBit(portRegister(), high);
+#else
+    digitalWrite(pin, high ? HIGH : LOW);
+#endif
+  }
+
+  static void toggle(void) {
+#ifdef __AVR__
+    pinRegister() = mask; // writing a one to PINx toggles PORTx, without a read-modify-write
+#else
+    digitalWrite(pin, digitalRead(pin) ? LOW : HIGH);
+#endif
+  }
+
+  static bool read(void) {
+#ifdef __AVR__
+    return (pinRegister() & mask) != 0;
+#else
+    return digitalRead(pin) == HIGH;
+#endif
+  }
+};
+
+template <uint8_t pin> constexpr uint8_t fastGroupMask(void) {
+  return FastPinRegisters<pin>::mask;
+}
+template <uint8_t first, uint8_t second, uint8_t... rest> constexpr uint8_t fastGroupMask(void) {
+  return FastPinRegisters<first>::mask | fastGroupMask<second, rest...>();
+}
+
+template <uint8_t pin> constexpr bool fastGroupOnePort(void) {
+  return true;
+}
+template <uint8_t first, uint8_t second, uint8_t... rest> constexpr bool fastGroupOnePort(void) {
+  return fastPinPorts[first] == fastPinPorts[second] && fastGroupOnePort<second, rest...>();
+}
+
+// Output pins sharing a port, written together.  Values are port masks built from pinMask<pin>().
+template <uint8_t... pins> class FastPinGroup {
+public:
+  static_assert(fastGroupOnePort<pins...>(), "a FastPinGroup's pins must share a port");
+
+  static constexpr uint8_t mask = fastGroupMask<pins...>();
+
+  template <uint8_t pin> static constexpr uint8_t pinMask(void) {
+    return FastPinRegisters<pin>::mask;
+  }
+
+  static void begin(void) {
+#ifdef __AVR__
+    update(ddrRegister(), mask);
+#else
+    const uint8_t each[] = {pins...};
+    for (uint8_t i = 0; i < sizeof(each); i++) {
+      pinMode(each[i], OUTPUT);
+    }
+#endif
+  }
+
+  // every pin in the group whose bit is set in high goes HIGH, the rest LOW, in one store
+  static void write(uint8_t high) {
+#ifdef __AVR__
+    update(portRegister(), high);
+#else
+    const uint8_t each[] = {pins...};
+    for (uint8_t i = 0; i < sizeof(each); i++) {
+      uint8_t pin = each[i];
+      digitalWrite(pin, (high & (1 << fastPinBits[pin])) ? HIGH : LOW);
+    }
+#endif
+  }
+
+private:
+#ifdef __AVR__
+  static constexpr uint16_t address = fastPortAddress(fastPinPorts[fastFirstPin(pins...)]);
+
+  static volatile uint8_t &ddrRegister(void) {
+    return *(volatile uint8_t *)(address + 1);
+  }
+  static volatile uint8_t &portRegister(void) {
+    return *(volatile uint8_t *)(address + 2);
+  }
+
+  // interrupts off so an ISR touching another pin of the port cannot be undone
+  static void update(volatile uint8_t &reg, uint8_t high) {
+    uint8_t sreg = SREG;
+    cli();
+    reg = (reg & ~mask) | (high & mask);
+    SREG = sreg;
+  }
+#endif
+};
+
+template <uint8_t pin, bool highIsOn = DigitalPinIO::highOn> class FastPinOut {
+public:
+  FastPinOut(uint8_t, bool) {
+    FastPinRegisters<pin>::mode(OUTPUT);
+    turnOff();
+  }
+
+  bool isOn(void) {
+    return _isOn;
+  }
+
+  bool isOff(void) {
+    return !_isOn;
+  }
+
+  void turnOn(void) {
+    FastPinRegisters<pin>::write(highIsOn);
+    _isOn = true;
+  }
+
+  void turnOff(void) {
+    FastPinRegisters<pin>::write(!highIsOn);
+    _isOn = false;
+  }
+
+  void toggle(void) {
+    FastPinRegisters<pin>::toggle();
+    _isOn = !_isOn;
+  }
+
+private:
+  bool _isOn;
+};
+
+template <uint8_t pin, bool highIsOn = DigitalPinIO::highOn> class FastPinIn {
+public:
+  FastPinIn(uint8_t, bool pullup, bool) {
+    FastPinRegisters<pin>::mode(pullup ? INPUT_PULLUP : INPUT);
+    _lastReadOn = false;
+    _valueHasChanged = false;
+    _wasOn = false;
+  }
+
+  bool isOn(void) {
+    bool on = FastPinRegisters<pin>::read() == highIsOn;
+    _valueHasChanged = on != _lastReadOn;
+    _lastReadOn = on;
+    return on;
+  }
+
+  bool isOff(void) {
+    return !isOn();
+  }
+
+  bool hasChanged(void) {
+    return _valueHasChanged;
+  }
+
+  // true once per off to on edge seen between two calls
+  bool wasTurnedOn(void) {
+    bool on = isOn();
+    bool turnedOn = on && !_wasOn;
+    _wasOn = on;
+    return turnedOn;
+  }
+
+private:
+  bool _lastReadOn;
+  bool _valueHasChanged;
+  bool _wasOn;
+};
+
+#endif
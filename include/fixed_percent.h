@@ -0,0 +1,33 @@
+/*
+    fixed_percent.h
+    2026-10-17
+
+    Fixed-point percentages for the battery and solar model
+
+    A FixedPercent counts 1/255ths of a percent, so 0 to 25500 is 0.0 to 100.0.
+        The scale is chosen so the model's arithmetic is exact in integers:
+            a photoresistor reading of L (0-255) was L / 2.55 percent, which is L * 100 here
+            a charge step of solar / 50 percent is then 2 * L
+            whole percent thresholds and power usages are n * 255
+    The Mega has no FPU, so this keeps the soft-float library out of the tick entirely.
+*/
+
+#ifndef fixed_percent_h
+#define fixed_percent_h
+
+#include <Arduino.h>
+
+typedef uint16_t FixedPercent;
+
+const FixedPercent fixedPercentScale = 255;
+
+constexpr FixedPercent fixedPercent(uint8_t percent) {
+  return percent * fixedPercentScale;
+}
+
+// truncated, as int() of the floating point value was
+inline int wholePercent(FixedPercent value) {
+  return value / fixedPercentScale;
+}
+
+#endif
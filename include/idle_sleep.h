@@ -0,0 +1,40 @@
+/*
+    idle_sleep.h
+    2026-10-17
+
+    Sleeps the CPU between ticks, and counts how long it slept
+
+    loop() has nothing to do for about 99% of each 100ms tick.  Rather than spin on millis(),
+        it calls sleep(), which puts the CPU in SLEEP_MODE_IDLE until the next interrupt.  Idle
+        mode stops only the CPU and flash clocks: the timers, ADC, TWI, UART and pin change
+        interrupts all keep running and any of them wakes it.
+    There is no separate wake-up timer for the next due tick.  Timer0's overflow (the millis()
+        interrupt) already fires every 1.024ms and cannot be stopped without stopping millis(),
+        so the CPU wakes at least that often, checks the time and goes back to sleep; the
+        awake time that costs is a few microseconds per millisecond.
+
+    asleepMicros() and awakeMicros() count since the last resetCounters() (or boot); keep the
+        window under an hour or so, as they are 32 bit microsecond counts.  The profiler reports
+        and resets them with its other statistics (see profiler.h).
+
+    Native build: sleep() moves the simulated clock on to the next millisecond interrupt.
+*/
+
+#ifndef idle_sleep_h
+#define idle_sleep_h
+
+#include <Arduino.h>
+
+const unsigned long idleWakeMicros = 1024; // Timer0 overflow
+
+class IdleSleep {
+public:
+  // until the next interrupt
+  static void sleep(void);
+
+  static unsigned long asleepMicros(void);
+  static unsigned long awakeMicros(void);
+  static void resetCounters(void);
+};
+
+#endif
@@ -0,0 +1,75 @@
+/*
+    input_engine.h
+    2026-10-17
+
+    Interrupt driven digital inputs: debounced, timestamped on/off and long press events
+
+    Each attached pin is a channel.  Raw edges are seen in interrupt context:
+        pin change interrupts   pins on the Mega's PCINT banks (10-15, 50-53, A8-A15) are
+                                reported the moment they change
+        sampler                 every other pin is read by a 1kHz sampler on Timer0's compare A
+                                interrupt (Timer0 also runs millis(); its compare match fires once
+                                per 1.024ms whatever OCR0A holds, so a PWM on pin 13 does no harm)
+    None of the dwelling's inputs are on PCINT pins today (see pins.h), so they are all sampled;
+        moving one to a PCINT pin needs no code change.
+
+    Debounce is by stability: a new level is accepted once no further edge has been seen for the
+        channel's debounceMillis, and the event carries the millis() of the first edge of the burst.
+        A pulse shorter than a tick but longer than the debounce is still reported, on and off.
+    Long press: a channel that stays on for longPressMillis (0 = never) reports InputHeld once.
+
+    Wake channels (attachWake) skip all of that: any edge just sets the channel's bit for
+        takeWakes(), for code that only needs to know something happened.  A wake channel may
+        also have a handler, called with the new level from the interrupt that saw the edge,
+        for code that has to act before the main loop comes round, such as a keypad finding
+        which key pulled a row low (see interrupt_keypad.h).
+
+    Events go into a single producer, single consumer ring (see spsc_ring.h): the interrupts
+        write, read() in the main loop takes them.  isOn() is the debounced state, kept current by the interrupts,
+        so asking for it never touches the pin.
+    The ring is sized for several ticks of the fastest possible bouncing on every channel; if it
+        ever fills, events are counted in overflows() rather than overwritten.
+
+    Native build: the simulated board reports every change of an attached pin, and read()
+        runs the sampler's debounce and long press step, since nothing else moves time there.
+*/
+
+#ifndef input_engine_h
+#define input_engine_h
+
+#include <Arduino.h>
+
+#include "spsc_ring.h"
+
+const uint8_t inputMaxChannels = 8;
+const uint8_t inputEventQueueSize = 32; // power of two, up to 128
+
+typedef enum {
+  InputTurnedOn = 0,
+  InputTurnedOff,
+  InputHeld
+} InputEventType;
+
+// source is the channel, payload the InputEventType
+typedef EventRecord<uint8_t> InputEvent;
+
+// runs in interrupt context
+typedef void (*InputWakeHandler)(void *context, uint8_t pin, uint8_t level, unsigned long now);
+
+class InputEngine {
+public:
+  // returns the channel, or -1 if every channel is taken
+  static int8_t attach(uint8_t pin, bool highIsOn, uint8_t debounceMillis, uint16_t longPressMillis);
+  // a channel whose edges only set its bit (1 << channel) for takeWakes(), and call handler
+  static int8_t attachWake(uint8_t pin, InputWakeHandler handler = NULL, void *context = NULL);
+  // enable the interrupts; call once, after the channels are attached
+  static void begin(void);
+
+  static bool read(InputEvent &event);
+  static bool isOn(uint8_t channel);
+  // true if any channel in mask has seen an edge since the last call; clears those bits
+  static bool takeWakes(uint8_t mask);
+  static unsigned long overflows(void);
+};
+
+#endif
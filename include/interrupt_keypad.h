@@ -0,0 +1,67 @@
+/*
+    interrupt_keypad.h
+    2026-10-17
+
+    Keypad that sleeps until a key is pressed
+
+    Keypad::getKey() runs a full matrix scan on every call: each column is switched to an output,
+        pulsed low, every row read, and the column switched back.  The panel is idle nearly
+        all of the time, so nearly all of that work finds nothing.
+
+    After useInterrupts(), InterruptKeypad drives every column low and leaves the rows pulled
+        up, so pressing any key pulls its row low.  The rows are input engine wake channels (see
+        input_engine.h), and a key is found the moment its row falls: the wake handler drives
+        one column at a time low, reads that row, drives them all low again and pushes the key
+        into a small ring.  getKey() pops the ring, so a tap shorter than a tick is still seen,
+        and a key held across ticks counts once; nothing is scanned while the panel is idle.
+    Debounce is by quiet: a row's fall counts as a press only if the row has seen no edge for
+        interruptKeypadDebounceMillis, so the bounces of a press or release are ignored.  Only
+        the first key down in a row is reported until that row is released.
+    The panel's rows (34-37) are not on PCINT pins, so the wake comes from the input engine's
+        1kHz sampler rather than a pin change interrupt; the scan runs in that interrupt, a few
+        pin operations per column, once per press.
+
+    Without useInterrupts() (or if the input engine has no channels left, or the keypad has more
+        than interruptKeypadMaxRows rows) it is a plain Keypad, scanned by each getKey().
+*/
+
+#ifndef interrupt_keypad_h
+#define interrupt_keypad_h
+
+#include <Arduino.h>
+#include <Keypad.h>
+
+#include "spsc_ring.h"
+
+const uint8_t interruptKeypadMaxRows = 4;
+const uint8_t interruptKeypadQueueSize = 8; // keys waiting for getKey(); power of two
+const uint8_t interruptKeypadDebounceMillis = 10;
+
+class InterruptKeypad : public Keypad {
+public:
+  InterruptKeypad(char *userKeymap, byte *row, byte *col, byte numRows, byte numCols);
+
+  // attach the rows to the input engine; call before InputEngine::begin()
+  bool useInterrupts(void);
+  // the oldest key pressed and not yet taken, or NO_KEY
+  char getKey(void);
+
+private:
+  static void wake(void *keypad, uint8_t pin, uint8_t level, unsigned long now);
+  void rowChanged(uint8_t pin, uint8_t level, unsigned long now);
+  char scanRow(uint8_t row);
+  void arm(void);
+
+  char *_keymap;
+  byte *_rowPins;
+  byte *_columnPins;
+  byte _rows;
+  byte _columns;
+  bool _interrupts;
+  bool _scanning;   // the wake handler is moving the columns, so the rows' edges are its own
+  uint8_t _rowsDown; // one bit per row whose key has been reported and not released
+  unsigned long _rowEdges[interruptKeypadMaxRows]; // millis() of each row's last edge
+  SpscRing<char, interruptKeypadQueueSize> _keys;  // pushed by the wake handler
+};
+
+#endif
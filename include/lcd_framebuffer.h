@@ -0,0 +1,60 @@
+/*
+    lcd_framebuffer.h
+    2026-10-17
+
+    Shadow frame buffer in front of a LiquidCrystal_I2C character display
+
+    Every byte sent to the panel costs two I2C nibbles, each three expander transactions plus
+        a 50us settle, so rewriting the whole status display every tick eats most of the tick.
+    LCDFrameBuffer is a Print like the display itself: setCursor()/print()/clear() only touch
+        a RAM copy of the frame.  update() compares that copy with what the panel is known to be
+        showing and sends just the runs of cells that differ.
+    Cursor moves are coalesced: the panel's address counter is tracked, so a run that starts
+        where the previous one ended needs no setCursor(), and runs separated by a single
+        unchanged cell are merged (rewriting one cell costs the same as one setCursor()).
+
+    Anything that changes the panel behind the buffer's back (init(), clear() on the display
+        itself) must be followed by panelCleared() or invalidate().
+    While the panel is still coming up (LiquidCrystal_I2C::initAsync()) update() sends nothing:
+        drawing goes on in the buffer and appears with the first update() after panelCleared().
+*/
+
+#ifndef LCD_FRAMEBUFFER_H
+#define LCD_FRAMEBUFFER_H
+
+#include "LiquidCrystal_I2C.h"
+#include <Arduino.h>
+
+const uint8_t lcdFrameColumns = 16;
+const uint8_t lcdFrameRows = 2;
+
+class LCDFrameBuffer : public Print {
+public:
+  LCDFrameBuffer(LiquidCrystal_I2C &panel);
+
+  void setCursor(uint8_t column, uint8_t row);
+  virtual size_t write(uint8_t value);
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  using Print::write;
+  void clear(void);
+
+  // send the cells that differ from the panel; returns the number of characters sent
+  uint8_t update(void);
+
+  // the panel has just been cleared to spaces
+  void panelCleared(void);
+  // the panel's contents are unknown: the next update() rewrites every cell
+  void invalidate(void);
+
+private:
+  LiquidCrystal_I2C &_panel;
+  char _frame[lcdFrameRows][lcdFrameColumns];
+  char _shown[lcdFrameRows][lcdFrameColumns];
+  bool _shownValid[lcdFrameRows][lcdFrameColumns];
+  uint8_t _column;
+  uint8_t _row;
+  uint8_t _panelColumn; // where the panel's address counter is, lcdFrameColumns if unknown
+  uint8_t _panelRow;
+};
+
+#endif
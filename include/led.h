@@ -5,6 +5,7 @@
     Classes to manage single color LED,
         Red/Green Bicolor LED
     Presumes HIGH is on, LOW is off
+    FastLED and FastRedGreenLED are the same with the pins fixed at compile time (see fast_pin.h)
 */
 
 #ifndef led_h
@@ -12,6 +13,8 @@
 
 #include <Arduino.h>
 
+#include "fast_pin.h"
+
 class LED {
     public:
         LED(uint8_t pin);
@@ -57,4 +60,75 @@ class RedGreenLED {
         bool _wasRed;
 };
 
-#endif
\ No newline at end of file
+template <uint8_t pin> class FastLED {
+    public:
+        FastLED(uint8_t) {
+            FastPinRegisters<pin>::mode(OUTPUT);
+            turnOff();
+        }
+        void turnOn() {
+            FastPinRegisters<pin>::write(HIGH);
+            _isOn = true;
+        }
+        void turnOff() {
+            FastPinRegisters<pin>::write(LOW);
+            _isOn = false;
+        }
+        bool isOn() {
+            return _isOn;
+        }
+    private:
+        bool _isOn;
+};
+
+// State is kept exactly as RedGreenLED keeps it, so the two are interchangeable.  Both pins must
+//   be on one port (see FastPinGroup): changing colour is a single store, with no instant at which
+//   both or neither are lit.
+template <uint8_t redPin, uint8_t greenPin> class FastRedGreenLED {
+    public:
+        FastRedGreenLED(uint8_t, uint8_t) {
+            _isOn = false;
+            _isRed = false;
+            _isGreen = false;
+            _wasRed = false;
+            Pins::begin();
+            turnOff();
+        }
+        bool isOn(void) {
+            return _isOn;
+        }
+        bool isRed(void) {
+            return _isRed;
+        }
+        bool isGreen(void) {
+            return _isGreen;
+        }
+        void turnOff(void) {
+            Pins::write(0);
+        }
+        void turnOnRed(void) {
+            Pins::write(Pins::template pinMask<redPin>());
+            _isOn = true;
+            _isRed = true;
+            _wasRed = true;
+        }
+        void turnOnGreen(void) {
+            Pins::write(Pins::template pinMask<greenPin>());
+            _isOn = true;
+            _isGreen = true;
+            _wasRed = false;
+        }
+        bool wasRed(void) {
+            return _wasRed;
+        }
+
+    private:
+        typedef FastPinGroup<redPin, greenPin> Pins;
+
+        bool _isOn;
+        bool _isRed;
+        bool _isGreen;
+        bool _wasRed;
+};
+
+#endif
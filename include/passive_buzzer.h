@@ -3,6 +3,10 @@
     Evan Robinson, 2023-10-10
 
     Class to manage Passive Buzzer
+
+    Each AlarmSignal is a tone pattern played by the ToneSequencer (see tone_sequencer.h); a
+        higher priority alarm cuts off a lower one: alert > power_critical > power_low.
+    Each new alarm, and any signal it does not know, is reported as a telemetry event.
 */
 
 #ifndef passive_buzzer_h
@@ -22,6 +26,7 @@ public:
   Buzzer(uint8_t pin);
   void alarm(AlarmSignals signal);
   void alarmOff(void);
+  AlarmSignals signal(void); // last raised, noAlarm once off
 
   void play(int frequency, unsigned long duration);
 
@@ -4,6 +4,9 @@
 
     Class to manage photoresistor on arduino
     Hand scaled -- recalibrate if you feel necessary
+
+    After useInterrupts() the level comes from the analog sampler (see analog_sampler.h):
+        oversampled and smoothed in the background, and free to read.
 */
 
 #ifndef photoresistor_h
@@ -11,16 +14,21 @@
 
 #include <Arduino.h>
 
+#include "fixed_percent.h"
+
 class PhotoResistor {
     public:
         PhotoResistor(uint8_t pin);
+        // sample in the background; call before AnalogSampler::begin()
+        bool useInterrupts(void);
 
-        // provides a returned value from 0.0 to 100.0
-        double value(void);
+        // provides a returned value from 0.0 to 100.0 percent (see fixed_percent.h)
+        FixedPercent value(void);
     protected:
     private:
         uint8_t _pin;
-        double   _value;
+        int8_t _channel; // analog sampler channel; -1 reads the pin
+        FixedPercent _value;
 };
 
 #endif
\ No newline at end of file
@@ -18,6 +18,8 @@ const uint8_t interiorLightsPWMControlPin = 12;
 const uint8_t alarmSystemPWMPin = 13;
 
 // Digital Pins
+//   The inputs here are not on the Mega's pin change interrupt banks, so the input engine samples
+//   them (see input_engine.h); moving one to 10-13, 50-53 or A8-A15 gets it a PCINT instead
 const uint8_t lockGreenPin = 22;
 const uint8_t lockRedPin = 23;
 const uint8_t interiorLightsButtonPin = 24;
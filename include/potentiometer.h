@@ -3,6 +3,9 @@
     Evan Robinson, 2023-10-11
 
     Class to manage Potentiometer
+
+    After useInterrupts() readings come from the analog sampler (see analog_sampler.h):
+        oversampled and smoothed in the background, and free to read.
 */
 
 #ifndef potentiometer
@@ -14,6 +17,8 @@
 class Potentiometer {
     public:
         Potentiometer(uint8_t pin);
+        // sample in the background; call before AnalogSampler::begin()
+        bool useInterrupts(void);
 
         int read(void);
         double readScaledTo(double minValue, double maxValue);
@@ -21,6 +26,7 @@ class Potentiometer {
     protected:
     private:
         uint8_t _pin;
+        int8_t _channel; // analog sampler channel; -1 reads the pin
         int _previousValue;
         int _currentValue;
 };
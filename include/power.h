@@ -11,6 +11,8 @@
 #define power_h
 
 #include "LiquidCrystal_I2C.h"
+#include "dwelling_config.h"
+#include "fixed_percent.h"
 #include "photoresistor.h"
 #include <Arduino.h>
 
@@ -22,22 +24,29 @@ typedef enum {
   PowerFull
 } HouseBatteryPowerLevel;
 
-class HouseBattery {
+// Config supplies the thresholds and charge rate (see dwelling_config.h)
+template <class Config> class BasicHouseBattery {
 public:
-  HouseBattery(void);
-  void usePower(double powerUsed);
-  void chargeBattery(double solarPower);
-
-  // provides a returned value from 0.0 to 100.0
-  double batteryLevel(void);
+  BasicHouseBattery(void);
+  void usePower(FixedPercent powerUsed);
+  void chargeBattery(FixedPercent solarPower);
+  // power from outside the solar array, such as a neighbour's battery; anything past full is lost
+  void receivePower(FixedPercent powerReceived);
+
+  // provides a returned value from 0.0 to 100.0 percent (see fixed_percent.h)
+  FixedPercent batteryLevel(void);
   HouseBatteryPowerLevel powerLevel(void);
 
   bool isCharging(void);
+  // state kept across a reset (see state_journal.h)
+  void restore(FixedPercent battery, bool charging);
 
 protected:
 private:
-  double _battery;
+  FixedPercent _battery;
   bool _charging;
 };
 
+typedef BasicHouseBattery<MegaPanel> HouseBattery;
+
 #endif
\ No newline at end of file
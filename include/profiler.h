@@ -0,0 +1,104 @@
+/*
+    profiler.h
+    2026-10-17
+
+    Loop timing instrumentation, compiled in only when AKIT_PROFILE is defined
+        (see [env:megaatmega2560_profile] in platformio.ini)
+
+    PROFILE_SCOPE(point) times the rest of the enclosing block with micros() and files the
+        duration under point.  PROFILE_TICK(duration, period) records a whole tick (as measured
+        by the scheduler) and the slack left before the next one.  PROFILE_REPORT(tickCount)
+        closes the window every profileReportTicks ticks and sends its report as telemetry.
+
+    Each point keeps a count, total, maximum and a log2 histogram: bucket 0 holds 0us,
+        bucket b holds [2^(b-1), 2^b) us, the last bucket holds everything longer.
+
+    Without AKIT_PROFILE every macro expands to nothing and none of this is compiled,
+        so the production firmware is unchanged.
+
+    The report shares the port with the telemetry stream, so it goes out as telemetry records
+        (see telemetry.h): a TelemetryDutyCycleRecord with the CPU's duty cycle over the window
+        (see idle_sleep.h), then a TelemetryProfileRecord and TelemetryHistogramRecords for each
+        point with any samples.  A closed window is kept aside and sent a few frames a tick, as
+        the queue has room to spare; nothing waits on the port.  It takes a handful of ticks,
+        far less than a window; a report still unsent when the next window closes is abandoned.
+    The telemetry decoder prints the reports to stderr, one line per point:
+        P <name> n=<count> avg=<us> max=<us> h=<bucket 0>,<bucket 1>,...   (trailing zeros dropped)
+        I awake=<us> asleep=<us>
+
+    The points are defined in every build, for the decoder.
+*/
+
+#ifndef PROFILER_H
+#define PROFILER_H
+
+typedef enum {
+  ProfileLighting = 0,
+  ProfileCharging,
+  ProfileMotion,
+  ProfileStatusDisplays,
+  ProfileBatteryLight,
+  ProfileUnlock,
+  ProfileInputs,
+  ProfileTelemetry,
+  ProfileJournal,
+  ProfileTick,
+  ProfileSlack,
+  profilePointCount
+} ProfilePoint;
+
+#ifdef AKIT_PROFILE
+
+#include <Arduino.h>
+
+#include "scheduler.h"
+
+const uint8_t profileBuckets = 18;        // 2^17us > 100ms, so a whole tick fits
+const int profileReportTicks = 600;       // one minute of ticks
+
+class Profiler {
+public:
+  static void record(ProfilePoint point, unsigned long micros);
+  static void recordTick(unsigned long tickMicros, unsigned long periodMicros);
+  // set the window aside for sending and start a new one
+  static void closeWindow(TickCount tickCount);
+  // queue as much of the closed window's report as telemetry can spare room for
+  static void sendReport(void);
+};
+
+class ProfileScope {
+public:
+  ProfileScope(ProfilePoint point) {
+    _point = point;
+    _start = micros();
+  }
+  ~ProfileScope(void) {
+    Profiler::record(_point, micros() - _start);
+  }
+
+private:
+  ProfilePoint _point;
+  unsigned long _start;
+};
+
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+#define PROFILE_SCOPE(point) ProfileScope PROFILE_CONCAT(profileScope, __LINE__)(point)
+#define PROFILE_TICK(tickMicros, periodMicros) Profiler::recordTick(tickMicros, periodMicros)
+#define PROFILE_REPORT(tickCount)                                                                                      \
+  do {                                                                                                                 \
+    if ((tickCount) % profileReportTicks == 0) {                                                                       \
+      Profiler::closeWindow(tickCount);                                                                                \
+    }                                                                                                                  \
+    Profiler::sendReport();                                                                                            \
+  } while (0)
+
+#else
+
+#define PROFILE_SCOPE(point)
+#define PROFILE_TICK(tickMicros, periodMicros)
+#define PROFILE_REPORT(tickCount)
+
+#endif
+
+#endif
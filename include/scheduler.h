@@ -0,0 +1,154 @@
+/*
+    scheduler.h
+    2026-10-17
+
+    Cooperative tick scheduler with a static task table
+
+    Each task is a method of the owner (the Dwelling) with the signature
+        void method(TickCount tickCount) and an entry in a const table giving
+            name        in PROGMEM; print it through (const __FlashStringHelper *)
+            period      run every period ticks
+            phase       ...on the ticks where tickCount % period == phase, so work with the same
+                        period can be spread over different ticks
+            priority    among the tasks due in one tick, higher priority runs first; equal
+                        priorities run in table order
+            deadline    microseconds from the start of the tick by which the task must finish
+
+    run() is called once per tick and records, per task, the last, worst and total run time and
+        the number of missed deadlines, plus the length of the whole tick.
+    Timing uses micros(), whose 4us resolution on the Mega is plenty for 100ms ticks.  One call
+        per task that runs: a task's time is counted from the end of the one before, so it takes
+        in the few instructions of bookkeeping between them.
+    Most tasks run every tick, and for those the tick count's 32 bit remainder, a library call
+        of several hundred cycles on the AVR, is not worked out.
+
+    The tick count is unsigned and 32 bits on every build.  A signed 16 bit int (the Mega's int)
+        goes negative after 55 minutes, where tickCount % period is never a positive phase.
+        At 100ms a tick, 32 bits wrap after 13.6 years; a period that does not divide 2^32 then
+        starts over from phase 0 once, early.
+*/
+
+#ifndef SCHEDULER_H
+#define SCHEDULER_H
+
+#include <Arduino.h>
+
+typedef uint32_t TickCount;
+
+template <class Owner> struct ScheduledTask {
+  const char *name;
+  void (Owner::*method)(TickCount tickCount);
+  uint8_t period;
+  uint8_t phase;
+  uint8_t priority;
+  uint16_t deadlineMicros;
+};
+
+typedef struct {
+  unsigned long runs;
+  unsigned long lastMicros;
+  unsigned long worstMicros;
+  unsigned long totalMicros;
+  unsigned long missedDeadlines;
+} TaskStatistics;
+
+template <class Owner, uint8_t maxTasks> class TaskScheduler {
+public:
+  TaskScheduler(Owner &owner) :
+      _owner(owner) {
+    _taskCount = 0;
+    resetStatistics();
+  }
+
+  // task is in PROGMEM, as the owner's table should be
+  bool addTask_P(const ScheduledTask<Owner> *task) {
+    ScheduledTask<Owner> copy;
+    memcpy_P(&copy, task, sizeof(copy));
+    return addTask(copy);
+  }
+
+  // insert in priority order; false if the table is full or the task could never run
+  bool addTask(const ScheduledTask<Owner> &task) {
+    if (_taskCount >= maxTasks || task.period == 0 || task.phase >= task.period) {
+      return false;
+    }
+    uint8_t slot = _taskCount;
+    while (slot > 0 && _tasks[slot - 1].priority < task.priority) {
+      _tasks[slot] = _tasks[slot - 1];
+      slot--;
+    }
+    _tasks[slot] = task;
+    _taskCount++;
+    return true;
+  }
+
+  void run(TickCount tickCount) {
+    unsigned long tickStart = micros();
+    unsigned long start = tickStart; // each task is timed from the end of the one before
+
+    for (uint8_t i = 0; i < _taskCount; i++) {
+      const ScheduledTask<Owner> &task = _tasks[i];
+      if (task.period != 1 && (tickCount % task.period) != task.phase) {
+        continue;
+      }
+
+      (_owner.*task.method)(tickCount);
+      unsigned long finish = micros();
+
+      TaskStatistics &statistics = _statistics[i];
+      unsigned long duration = finish - start;
+      statistics.runs++;
+      statistics.lastMicros = duration;
+      statistics.totalMicros += duration;
+      if (duration > statistics.worstMicros) {
+        statistics.worstMicros = duration;
+      }
+      if ((finish - tickStart) > task.deadlineMicros) {
+        statistics.missedDeadlines++;
+      }
+      start = finish;
+    }
+
+    _lastTickMicros = start - tickStart;
+    if (_lastTickMicros > _worstTickMicros) {
+      _worstTickMicros = _lastTickMicros;
+    }
+  }
+
+  uint8_t taskCount(void) {
+    return _taskCount;
+  }
+
+  // tasks are numbered in run order, i.e. by priority
+  const ScheduledTask<Owner> &task(uint8_t index) {
+    return _tasks[index];
+  }
+
+  const TaskStatistics &statistics(uint8_t index) {
+    return _statistics[index];
+  }
+
+  unsigned long lastTickMicros(void) {
+    return _lastTickMicros;
+  }
+
+  unsigned long worstTickMicros(void) {
+    return _worstTickMicros;
+  }
+
+  void resetStatistics(void) {
+    memset(_statistics, 0, sizeof(_statistics));
+    _lastTickMicros = 0;
+    _worstTickMicros = 0;
+  }
+
+private:
+  Owner &_owner;
+  ScheduledTask<Owner> _tasks[maxTasks];
+  TaskStatistics _statistics[maxTasks];
+  uint8_t _taskCount;
+  unsigned long _lastTickMicros;
+  unsigned long _worstTickMicros;
+};
+
+#endif
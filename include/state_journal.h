@@ -0,0 +1,59 @@
+/*
+    state_journal.h
+    2026-10-17
+
+    Keeps the dwelling's state in EEPROM across resets and brownouts
+
+    What survives: the battery level and charging flag, so a reset does not start the dwelling
+        on a flat battery, and the PIN failure count, so a power cycle does not clear a lockout.
+
+    Layout: a journal of journalSlots 8 byte records at journalAddress, each
+        sequence (2), battery (2), unlock failures, flags, layout version, CRC-8 (see crc8.h)
+        Every record goes to the slot after the last one, so the writes wear all the slots
+        evenly; with 128 slots and a record a minute each cell sees about 4,100 writes a year,
+        against the 100,000 the part is rated for.  The CRC comes last, so a record torn by a
+        reset mid-write fails its check and the one before it stands.
+    restore() reads every slot and keeps the valid record with the newest sequence number (they
+        wrap, compared as a signed difference): about 1KB of EEPROM reads and a CRC per slot,
+        2 to 3ms on the Mega.  An erased or foreign EEPROM has no valid record.
+
+    Writing: save() only notes the state.  service() starts a record when the state differs
+        from the last one written, and either save() asked for it now (PIN failures) or
+        journalIntervalMillis has passed since the last (the battery, which changes every
+        second in sunlight).  A byte takes 3.4ms to write, so rather than wait for the EEPROM,
+        service() writes while it is ready and returns: call it often (loop() does, on every
+        wake) and a record is done in about 30ms, at no cost to the tick.
+
+    One journal per board.  Native build: each SimBoard's EEPROM has its own (see board_local.h).
+*/
+
+#ifndef state_journal_h
+#define state_journal_h
+
+#include <Arduino.h>
+
+#include "fixed_percent.h"
+
+typedef struct {
+  FixedPercent battery;
+  bool charging;
+  uint8_t unlockFailures;
+} PersistentState;
+
+const uint16_t journalAddress = 0;
+const uint8_t journalSlots = 128;
+const unsigned long journalIntervalMillis = 60000L;
+
+class StateJournal {
+public:
+  // the newest valid record; false, with state untouched, if there is none
+  static bool restore(PersistentState &state);
+  // journal state: now, or once journalIntervalMillis has passed since the last record
+  static void save(const PersistentState &state, bool now);
+  // write what the EEPROM will take without waiting
+  static void service(void);
+
+  static unsigned long records(void); // written since boot
+};
+
+#endif
@@ -0,0 +1,133 @@
+/*
+    telemetry.h
+    2026-10-17
+
+    Compact binary telemetry over Serial
+
+    Text at 115200 baud costs 87us a character, and Serial.print() blocks as soon as the core's
+        64 byte TX buffer is full.  Instead the dwelling sends one fixed layout
+        TelemetryTickRecord per tick (11 bytes) and a TelemetryEventRecord (8 bytes) for
+        anything worth noting between them.  Records are packed and little endian, as both the
+        AVR and the host are.
+
+    Framing: a record is followed by its CRC-8 (see crc8.h), COBS encoded so the frame
+        holds no zero byte, and ended by a zero.  A tick costs 14 bytes on the wire, 1.2ms of
+        the 100ms tick at 115200 baud.  A reader that joins mid-stream, or misses bytes, picks
+        up again at the next zero and drops any frame whose length or CRC is wrong.
+
+    Nothing here waits.  tick() and event() queue whole frames in a 128 byte ring (see
+        spsc_ring.h); a frame that does not fit is dropped and counted, and the count goes out
+        as a TelemetryDropped event once there is room again.  pump() moves queued bytes into
+        the core's TX buffer, never more than availableForWrite() says fit, and the UART
+        interrupt does the rest; loop() calls it every time it wakes.  (The core owns the UART's
+        interrupt, so this tops up its buffer rather than driving the UART itself.)
+    The profile build's report (see profiler.h) goes out as TelemetryProfile,
+        TelemetryHistogram and TelemetryDutyCycle records through background(), which only
+        takes a frame when the queue can spare the room, so it never crowds out a tick.
+
+    Host: src/native/telemetry_decode.cpp turns a captured stream into CSV.
+*/
+
+#ifndef telemetry_h
+#define telemetry_h
+
+#include <Arduino.h>
+
+typedef enum {
+  TelemetryTick = 1,
+  TelemetryEvent,
+  TelemetryProfile, // the profile build's report, see profiler.h
+  TelemetryHistogram,
+  TelemetryDutyCycle
+} TelemetryRecordType;
+
+typedef enum {
+  TelemetrySetupComplete = 1,
+  TelemetryUnlocked,
+  TelemetryBadCode,            // value: failures so far
+  TelemetryLockedOut,
+  TelemetryAlarm,              // value: the AlarmSignals raised
+  TelemetryUnknownAlarmSignal, // value: the signal
+  TelemetryDropped             // value: frames dropped for want of room since the last report
+} TelemetryEventCode;
+
+// TelemetryTickRecord.flags
+const uint16_t telemetryInteriorLights = 0x0001;
+const uint16_t telemetryExteriorLights = 0x0002;
+const uint16_t telemetryAlertLight = 0x0004;
+const uint16_t telemetryMotion = 0x0008;
+const uint16_t telemetryInteriorButton = 0x0010;
+const uint16_t telemetryExteriorButton = 0x0020;
+const uint16_t telemetryCharging = 0x0040;
+const uint16_t telemetryUnlocked = 0x0080;
+const uint16_t telemetrySounding = 0x0100; // the buzzer is playing
+
+typedef struct __attribute__((packed)) {
+  uint8_t type;       // TelemetryTick
+  uint16_t tickCount; // the loop's tick count, low 16 bits
+  uint16_t battery;   // FixedPercent
+  uint16_t solar;     // FixedPercent
+  uint16_t flags;
+  uint8_t alarm;      // AlarmSignals last raised
+  uint8_t powerLevel; // HouseBatteryPowerLevel
+} TelemetryTickRecord;
+
+typedef struct __attribute__((packed)) {
+  uint8_t type; // TelemetryEvent
+  uint32_t millis;
+  uint8_t code; // TelemetryEventCode
+  int16_t value;
+} TelemetryEventRecord;
+
+// a profile window opens with this, then each ProfilePoint with samples has a TelemetryProfile
+//   record and its histogram's buckets, trailing zeros dropped, in TelemetryHistogram records
+typedef struct __attribute__((packed)) {
+  uint8_t type;       // TelemetryDutyCycle
+  uint16_t tickCount; // the tick the window closed on, low 16 bits
+  uint32_t awake;     // us, see idle_sleep.h
+  uint32_t asleep;
+} TelemetryDutyCycleRecord;
+
+typedef struct __attribute__((packed)) {
+  uint8_t type;  // TelemetryProfile
+  uint8_t point; // ProfilePoint
+  uint16_t count;
+  uint32_t total; // us
+  uint32_t maximum;
+} TelemetryProfileRecord;
+
+const uint8_t telemetryHistogramBuckets = 4;
+
+typedef struct __attribute__((packed)) {
+  uint8_t type;  // TelemetryHistogram
+  uint8_t point; // ProfilePoint
+  uint8_t first; // the bucket in buckets[0]
+  uint16_t buckets[telemetryHistogramBuckets];
+} TelemetryHistogramRecord;
+
+const uint8_t telemetryBufferSize = 128;
+const uint8_t telemetryMaxRecord = sizeof(TelemetryProfileRecord); // the largest
+// COBS adds a byte per 254, here always one, then the terminating zero
+const uint8_t telemetryMaxFrame = telemetryMaxRecord + 1 + 2;
+
+class Telemetry {
+public:
+  // type is filled in; false if there was no room
+  static bool tick(TelemetryTickRecord &record);
+  static bool event(TelemetryEventCode code, int16_t value);
+  // for records that can wait (the profile report): record, type filled in, is queued only if that
+  //   leaves room for a tick and a drop report, and is not counted as dropped otherwise
+  static bool background(const void *record, uint8_t length);
+  // hand queued bytes to Serial, as many as it can take without blocking
+  static void pump(void);
+
+  static uint8_t pending(void);
+  static unsigned long dropped(void); // frames, since boot
+
+  // for the decoder: frame is the bytes between two zeros; returns the length of the record it
+  //   carried, or 0 if it is malformed, fails its CRC or does not fit in maxLength; record needs
+  //   only maxLength bytes
+  static uint8_t decodeFrame(const uint8_t *frame, uint8_t length, uint8_t *record, uint8_t maxLength);
+};
+
+#endif
@@ -0,0 +1,50 @@
+/*
+    tone_sequencer.h
+    2026-10-17
+
+    Plays tone patterns on the buzzer from a timer interrupt
+
+    A pattern is a PROGMEM table of steps (frequency, duration) played in order, the whole table
+        repeated a given number of times (0 = until stopped or preempted).  A step of frequency
+        0 is a rest.
+    Steps are timed by Timer0's compare B interrupt, which fires once per 1.024ms alongside
+        millis(); at the end of each step the interrupt calls tone() for the next one (tone()
+        itself runs on Timer2).  The interrupt is only enabled while a pattern plays, so a
+        siren costs the main loop one play() call and a silent buzzer costs nothing.
+
+    Priorities: play() starts its pattern if nothing is playing or if its priority is at least
+        that of the pattern playing, which is cut off; otherwise it is refused.  Finishing or
+        stop() leaves the sequencer free for any priority.
+
+    One buzzer per program.  Native build: the interrupt is a SimBoard timer (see sim_board.h).
+*/
+
+#ifndef tone_sequencer_h
+#define tone_sequencer_h
+
+#include <Arduino.h>
+
+typedef struct {
+  uint16_t frequency; // Hz; 0 is a rest
+  uint16_t durationMillis;
+} ToneStep;
+
+typedef struct {
+  const ToneStep *steps; // PROGMEM
+  uint8_t stepCount;
+  uint8_t repeats; // times through the steps; 0 repeats until stopped or preempted
+} TonePattern;
+
+const unsigned long toneSequencerTickMicros = 1024; // 64 * 256 / 16MHz
+
+class ToneSequencer {
+public:
+  static void begin(uint8_t pin);
+  // pattern is in PROGMEM; false if something of higher priority is playing
+  static bool play(const TonePattern *pattern, uint8_t priority);
+  static void stop(void);
+  static bool isPlaying(void);
+  static uint8_t priority(void); // of the pattern playing
+};
+
+#endif
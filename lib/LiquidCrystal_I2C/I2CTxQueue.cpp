@@ -0,0 +1,131 @@
+/*
+    I2CTxQueue.cpp
+    2026-10-17
+
+    Interrupt driven, write-only I2C master for LiquidCrystal_I2C (AKit2 fork)
+    Design notes are in the .h file
+*/
+
+#include "I2CTxQueue.h"
+
+#ifdef LCD_I2C_QUEUE
+
+#include <Arduino.h>
+#include <avr/interrupt.h>
+#include <util/twi.h>
+
+#include "spsc_ring.h"
+
+// write() is the producer, the ISR the consumer
+static SpscRing<uint8_t, I2C_TX_QUEUE_SIZE> queue;
+static volatile uint8_t slaveAddress = 0;
+static volatile bool busy = false;
+static volatile uint16_t failures = 0;
+
+static inline void sendStart(void) {
+  TWCR = _BV(TWINT) | _BV(TWSTA) | _BV(TWEN) | _BV(TWIE);
+}
+
+static inline void sendStop(void) {
+  TWCR = _BV(TWINT) | _BV(TWSTO) | _BV(TWEN);
+  busy = false;
+}
+
+// start a transaction if there is something to send and the bus is idle
+static void kick(void) {
+  if (!busy && !queue.empty()) {
+    while (TWCR & _BV(TWSTO)) {
+      // previous STOP still on the wire
+    }
+    busy = true;
+    sendStart();
+  }
+}
+
+void I2CTxQueue::begin(void) {
+  // internal pullups on SDA and SCL, as Wire.begin() does
+  digitalWrite(SDA, HIGH);
+  digitalWrite(SCL, HIGH);
+
+  TWSR = 0; // prescaler 1
+  TWBR = ((F_CPU / I2C_TX_CLOCK) - 16) / 2;
+  TWCR = _BV(TWEN);
+}
+
+void I2CTxQueue::write(uint8_t address, uint8_t data) {
+  if (address != slaveAddress) {
+    flush();
+    slaveAddress = address;
+  }
+
+  while (queue.full()) {
+    // the ISR is draining it
+  }
+  queue.push(data);
+
+  // The ISR clears busy only after finding the queue empty, and head was advanced above,
+  //   so either it has already seen this byte or the bus is idle and needs a START.
+  kick();
+}
+
+void I2CTxQueue::flush(void) {
+  do {
+    kick(); // restarts after a transaction was abandoned with bytes left
+  } while (busy || !queue.empty());
+  while (TWCR & _BV(TWSTO)) {
+  }
+}
+
+bool I2CTxQueue::idle(void) {
+  return !busy;
+}
+
+uint8_t I2CTxQueue::pending(void) {
+  return queue.count();
+}
+
+uint16_t I2CTxQueue::errors(void) {
+  uint8_t sreg = SREG;
+  cli();
+  uint16_t count = failures;
+  SREG = sreg;
+  return count;
+}
+
+ISR(TWI_vect) {
+  switch (TW_STATUS) {
+  case TW_START:
+  case TW_REP_START:
+    TWDR = (slaveAddress << 1) | TW_WRITE;
+    TWCR = _BV(TWINT) | _BV(TWEN) | _BV(TWIE);
+    break;
+
+  case TW_MT_SLA_ACK:
+  case TW_MT_DATA_ACK: {
+    uint8_t data;
+    if (queue.pop(data)) {
+      TWDR = data;
+      TWCR = _BV(TWINT) | _BV(TWEN) | _BV(TWIE);
+    }
+    else {
+      sendStop();
+    }
+    break;
+  }
+
+  case TW_MT_SLA_NACK:
+    // nobody at that address: drop what was queued for it rather than retry forever
+    queue.drop();
+    failures++;
+    sendStop();
+    break;
+
+  default:
+    // data NACK, lost arbitration or bus error: end this transaction, the next write restarts
+    failures++;
+    sendStop();
+    break;
+  }
+}
+
+#endif
@@ -0,0 +1,55 @@
+/*
+    I2CTxQueue.h
+    2026-10-17
+
+    Interrupt driven, write-only I2C master for LiquidCrystal_I2C (AKit2 fork)
+
+    Bytes are queued in a lock-free ring (see spsc_ring.h) and the TWI interrupt streams them
+        to the expander.
+        The first byte queued on an idle bus sends START and the address; after that the ISR keeps
+        the transaction open for as long as bytes keep arriving and sends STOP when the queue runs
+        dry.  The PCF8574 latches every data byte of a transaction onto its pins, so a stream of
+        port values needs no per-byte START/address overhead.
+    At 100kHz each byte occupies the bus for 9 clocks (90us), longer than both the HD44780's
+        enable pulse (450ns) and its command settle time (37us), so the bus clock itself provides
+        the controller's timing.  Longer waits (clear, home) are padded with idle bytes.
+
+    The caller only pays for the enqueue; it spins only if the queue is full.
+
+    Only on AVRs with a TWI (and not with LCD_I2C_BLOCKING defined); elsewhere
+        LiquidCrystal_I2C keeps using Wire.
+    The queue owns the TWI and its interrupt, so it cannot share a build with Wire: nothing
+        includes Wire.h alongside it, and the megaatmega2560 env lib_ignores Wire.
+*/
+
+#ifndef I2CTxQueue_h
+#define I2CTxQueue_h
+
+#include <inttypes.h>
+
+#if defined(__AVR__) && defined(TWCR) && !defined(LCD_I2C_BLOCKING)
+#define LCD_I2C_QUEUE
+#endif
+
+#ifdef LCD_I2C_QUEUE
+
+#define I2C_TX_QUEUE_SIZE 128 // power of two, up to 128
+#define I2C_TX_CLOCK 100000L  // PCF8574 maximum
+#define I2C_TX_BYTE_MICROS (9 * 1000000L / I2C_TX_CLOCK)
+
+class I2CTxQueue {
+public:
+  static void begin(void);
+  // queue data for address; waits for the queue to empty first if the address changes
+  static void write(uint8_t address, uint8_t data);
+  // wait until every queued byte has been sent and the bus has stopped
+  static void flush(void);
+  static bool idle(void);
+  static uint8_t pending(void);
+  // transactions abandoned on NACK or bus error
+  static uint16_t errors(void);
+};
+
+#endif
+
+#endif
@@ -0,0 +1,480 @@
+// Based on the work by DFRobot
+
+#include "LiquidCrystal_I2C.h"
+#include <inttypes.h>
+#if defined(ARDUINO) && ARDUINO >= 100
+
+#include "Arduino.h"
+
+#define printIIC(args)	Wire.write(args)
+inline size_t LiquidCrystal_I2C::write(uint8_t value) {
+	send(value, Rs);
+	return 1;
+}
+
+// Each character is two nibbles of three port values (data, data+EN, data), the same bytes
+// write4bits() sends one transaction at a time.  Consecutive bytes of a transaction are a bus
+// byte apart (90us at 100kHz), which already covers the enable pulse and settle times, so a
+// whole Wire buffer of characters goes out under one address.  On the queue every byte is
+// already streamed in one transaction and only the per-character calls are saved.
+size_t LiquidCrystal_I2C::write(const uint8_t *buffer, size_t size) {
+#ifdef LCD_I2C_QUEUE
+	for (size_t i = 0; i < size; i++) {
+		uint8_t value = buffer[i];
+		write4bits((value & 0xf0) | Rs);
+		write4bits(((value << 4) & 0xf0) | Rs);
+	}
+#else
+	const uint8_t bytesPerChar = 6;
+	uint8_t encoded[BUFFER_LENGTH];
+	size_t i = 0;
+	while (i < size) {
+		uint8_t length = 0;
+		while (i < size && length + bytesPerChar <= BUFFER_LENGTH) {
+			uint8_t value = buffer[i++];
+			length += encode4bits((value & 0xf0) | Rs, &encoded[length]);
+			length += encode4bits(((value << 4) & 0xf0) | Rs, &encoded[length]);
+		}
+		Wire.beginTransmission(_Addr);
+		Wire.write(encoded, length);
+		Wire.endTransmission();
+	}
+#endif
+	return size;
+}
+
+#else
+#include "WProgram.h"
+
+#define printIIC(args)	Wire.send(args)
+inline void LiquidCrystal_I2C::write(uint8_t value) {
+	send(value, Rs);
+}
+
+#endif
+#ifndef LCD_I2C_QUEUE
+#include "Wire.h"
+#ifndef BUFFER_LENGTH
+#define BUFFER_LENGTH 32
+#endif
+#endif
+
+// AKit2 fork: on AVRs with a TWI the expander is written through I2CTxQueue, which streams
+// the port values from the TWI interrupt.  The HD44780's setup and settle times then come from
+// the bus clock (90us a byte) and longer waits are padded with idle bytes, so nothing below
+// busy-waits except begin()'s power-on delays, which initAsync() and poll() avoid as well.
+// Elsewhere the original blocking Wire path is kept.
+
+
+// When the display powers up, it is configured as follows:
+//
+// 1. Display clear
+// 2. Function set: 
+//    DL = 1; 8-bit interface data 
+//    N = 0; 1-line display 
+//    F = 0; 5x8 dot character font 
+// 3. Display on/off control: 
+//    D = 0; Display off 
+//    C = 0; Cursor off 
+//    B = 0; Blinking off 
+// 4. Entry mode set: 
+//    I/D = 1; Increment by 1
+//    S = 0; No shift 
+//
+// Note, however, that resetting the Arduino doesn't reset the LCD, so we
+// can't assume that its in that state when a sketch starts (and the
+// LiquidCrystal constructor is called).
+
+LiquidCrystal_I2C::LiquidCrystal_I2C(uint8_t lcd_Addr,uint8_t lcd_cols,uint8_t lcd_rows)
+{
+  _Addr = lcd_Addr;
+  _cols = lcd_cols;
+  _rows = lcd_rows;
+  _backlightval = LCD_NOBACKLIGHT;
+  _initStep = LCD_INIT_IDLE;
+  _stepWait = 0;
+  _stepStarted = 0;
+}
+
+void LiquidCrystal_I2C::oled_init(){
+  _oled = true;
+	init_priv();
+}
+
+void LiquidCrystal_I2C::init(){
+	init_priv();
+}
+
+void LiquidCrystal_I2C::init_priv()
+{
+#ifdef LCD_I2C_QUEUE
+	I2CTxQueue::begin();
+#else
+	Wire.begin();
+#endif
+	_displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
+	begin(_cols, _rows);  
+}
+
+void LiquidCrystal_I2C::begin(uint8_t cols, uint8_t lines, uint8_t dotsize) {
+	prepare(lines, dotsize);
+	for (_initStep = 0; _initStep < LCD_INIT_STEPS; _initStep++) {
+		waitMicroseconds(_stepWait);
+		_stepWait = initStep(_initStep);
+	}
+	waitMicroseconds(_stepWait);
+	_initStep = LCD_INIT_DONE;
+}
+
+// AKit2 fork: the same bring-up without waiting.  initAsync() starts it and each poll() sends
+// the next step once the previous one's delay has passed, so the sketch runs meanwhile.  On the
+// queue a delay counts from when the step's bytes have left it.
+void LiquidCrystal_I2C::initAsync(){
+#ifdef LCD_I2C_QUEUE
+	I2CTxQueue::begin();
+#else
+	Wire.begin();
+#endif
+	_displayfunction = LCD_4BITMODE | LCD_1LINE | LCD_5x8DOTS;
+	prepare(_rows, LCD_5x8DOTS);
+	_initStep = 0;
+	_stepStarted = micros();
+}
+
+bool LiquidCrystal_I2C::poll(){
+	if (_initStep == LCD_INIT_DONE || _initStep == LCD_INIT_IDLE) {
+		return _initStep == LCD_INIT_DONE;
+	}
+#ifdef LCD_I2C_QUEUE
+	if (!I2CTxQueue::idle()) {
+		_stepStarted = micros();
+		return false;
+	}
+#endif
+	if (micros() - _stepStarted < _stepWait) {
+		return false;
+	}
+	if (_initStep == LCD_INIT_STEPS) {
+		_initStep = LCD_INIT_DONE;
+		return true;
+	}
+	_stepWait = initStep(_initStep++);
+	_stepStarted = micros();
+	return false;
+}
+
+bool LiquidCrystal_I2C::ready(){
+	return _initStep == LCD_INIT_DONE;
+}
+
+void LiquidCrystal_I2C::prepare(uint8_t lines, uint8_t dotsize) {
+	if (lines > 1) {
+		_displayfunction |= LCD_2LINE;
+	}
+	_numlines = lines;
+
+	// for some 1 line displays you can select a 10 pixel high font
+	if ((dotsize != 0) && (lines == 1)) {
+		_displayfunction |= LCD_5x10DOTS;
+	}
+
+	// SEE PAGE 45/46 FOR INITIALIZATION SPECIFICATION!
+	// according to datasheet, we need at least 40ms after power rises above 2.7V
+	// before sending commands. Arduino can turn on way befer 4.5V so we'll wait 50
+	_stepWait = 50000L;
+}
+
+// One step of the power-on sequence; returns the microseconds to wait before the next
+unsigned long LiquidCrystal_I2C::initStep(uint8_t step) {
+	switch (step) {
+	case 0:
+		// Now we pull both RS and R/W low to begin commands
+		expanderWrite(_backlightval);	// reset expanderand turn backlight off (Bit 8 =1)
+		return 1000000L;
+
+	//put the LCD into 4 bit mode
+	// this is according to the hitachi HD44780 datasheet
+	// figure 24, pg 46
+	case 1:
+		// we start in 8bit mode, try to set 4 bit mode
+		write4bits(0x03 << 4);
+		return 4500; // wait min 4.1ms
+	case 2:
+		// second try
+		write4bits(0x03 << 4);
+		return 4500; // wait min 4.1ms
+	case 3:
+		// third go!
+		write4bits(0x03 << 4);
+		return 150;
+
+	case 4:
+		// finally, set to 4-bit interface
+		write4bits(0x02 << 4);
+
+		// set # lines, font size, etc.
+		command(LCD_FUNCTIONSET | _displayfunction);
+
+		// turn the display on with no cursor or blinking default
+		_displaycontrol = LCD_DISPLAYON | LCD_CURSOROFF | LCD_BLINKOFF;
+		display();
+
+		// clear it off
+		command(LCD_CLEARDISPLAY);
+		return 2000; // this command takes a long time!
+
+	default:
+		if (_oled) setCursor(0,0);
+
+		// Initialize to default text direction (for roman languages)
+		_displaymode = LCD_ENTRYLEFT | LCD_ENTRYSHIFTDECREMENT;
+
+		// set the entry mode
+		command(LCD_ENTRYMODESET | _displaymode);
+
+		command(LCD_RETURNHOME);  // set cursor position to zero
+		return 2000;  // this command takes a long time!
+	}
+}
+
+/********** high level commands, for the user! */
+void LiquidCrystal_I2C::clear(){
+	command(LCD_CLEARDISPLAY);// clear display, set cursor position to zero
+	waitMicroseconds(2000);  // this command takes a long time!
+  if (_oled) setCursor(0,0);
+}
+
+void LiquidCrystal_I2C::home(){
+	command(LCD_RETURNHOME);  // set cursor position to zero
+	waitMicroseconds(2000);  // this command takes a long time!
+}
+
+void LiquidCrystal_I2C::setCursor(uint8_t col, uint8_t row){
+	int row_offsets[] = { 0x00, 0x40, 0x14, 0x54 };
+	if ( row > _numlines ) {
+		row = _numlines-1;    // we count rows starting w/0
+	}
+	command(LCD_SETDDRAMADDR | (col + row_offsets[row]));
+}
+
+// Turn the display on/off (quickly)
+void LiquidCrystal_I2C::noDisplay() {
+	_displaycontrol &= ~LCD_DISPLAYON;
+	command(LCD_DISPLAYCONTROL | _displaycontrol);
+}
+void LiquidCrystal_I2C::display() {
+	_displaycontrol |= LCD_DISPLAYON;
+	command(LCD_DISPLAYCONTROL | _displaycontrol);
+}
+
+// Turns the underline cursor on/off
+void LiquidCrystal_I2C::noCursor() {
+	_displaycontrol &= ~LCD_CURSORON;
+	command(LCD_DISPLAYCONTROL | _displaycontrol);
+}
+void LiquidCrystal_I2C::cursor() {
+	_displaycontrol |= LCD_CURSORON;
+	command(LCD_DISPLAYCONTROL | _displaycontrol);
+}
+
+// Turn on and off the blinking cursor
+void LiquidCrystal_I2C::noBlink() {
+	_displaycontrol &= ~LCD_BLINKON;
+	command(LCD_DISPLAYCONTROL | _displaycontrol);
+}
+void LiquidCrystal_I2C::blink() {
+	_displaycontrol |= LCD_BLINKON;
+	command(LCD_DISPLAYCONTROL | _displaycontrol);
+}
+
+// These commands scroll the display without changing the RAM
+void LiquidCrystal_I2C::scrollDisplayLeft(void) {
+	command(LCD_CURSORSHIFT | LCD_DISPLAYMOVE | LCD_MOVELEFT);
+}
+void LiquidCrystal_I2C::scrollDisplayRight(void) {
+	command(LCD_CURSORSHIFT | LCD_DISPLAYMOVE | LCD_MOVERIGHT);
+}
+
+// This is for text that flows Left to Right
+void LiquidCrystal_I2C::leftToRight(void) {
+	_displaymode |= LCD_ENTRYLEFT;
+	command(LCD_ENTRYMODESET | _displaymode);
+}
+
+// This is for text that flows Right to Left
+void LiquidCrystal_I2C::rightToLeft(void) {
+	_displaymode &= ~LCD_ENTRYLEFT;
+	command(LCD_ENTRYMODESET | _displaymode);
+}
+
+// This will 'right justify' text from the cursor
+void LiquidCrystal_I2C::autoscroll(void) {
+	_displaymode |= LCD_ENTRYSHIFTINCREMENT;
+	command(LCD_ENTRYMODESET | _displaymode);
+}
+
+// This will 'left justify' text from the cursor
+void LiquidCrystal_I2C::noAutoscroll(void) {
+	_displaymode &= ~LCD_ENTRYSHIFTINCREMENT;
+	command(LCD_ENTRYMODESET | _displaymode);
+}
+
+// Allows us to fill the first 8 CGRAM locations
+// with custom characters
+void LiquidCrystal_I2C::createChar(uint8_t location, uint8_t charmap[]) {
+	location &= 0x7; // we only have 8 locations 0-7
+	command(LCD_SETCGRAMADDR | (location << 3));
+	for (int i=0; i<8; i++) {
+		write(charmap[i]);
+	}
+}
+
+//createChar with PROGMEM input
+void LiquidCrystal_I2C::createChar(uint8_t location, const char *charmap) {
+	location &= 0x7; // we only have 8 locations 0-7
+	command(LCD_SETCGRAMADDR | (location << 3));
+	for (int i=0; i<8; i++) {
+	    	write(pgm_read_byte_near(charmap++));
+	}
+}
+
+// Turn the (optional) backlight off/on
+void LiquidCrystal_I2C::noBacklight(void) {
+	_backlightval=LCD_NOBACKLIGHT;
+	expanderWrite(0);
+}
+
+void LiquidCrystal_I2C::backlight(void) {
+	_backlightval=LCD_BACKLIGHT;
+	expanderWrite(0);
+}
+
+
+
+/*********** mid level commands, for sending data/cmds */
+
+inline void LiquidCrystal_I2C::command(uint8_t value) {
+	send(value, 0);
+}
+
+
+/************ low level data pushing commands **********/
+
+// write either command or data
+void LiquidCrystal_I2C::send(uint8_t value, uint8_t mode) {
+	uint8_t highnib=value&0xf0;
+	uint8_t lownib=(value<<4)&0xf0;
+       write4bits((highnib)|mode);
+	write4bits((lownib)|mode); 
+}
+
+void LiquidCrystal_I2C::write4bits(uint8_t value) {
+	expanderWrite(value);
+	pulseEnable(value);
+}
+
+// the port values write4bits() sends for value, for packing several nibbles into one transaction
+uint8_t LiquidCrystal_I2C::encode4bits(uint8_t value, uint8_t *port) {
+	port[0] = value | _backlightval;
+	port[1] = value | En | _backlightval;
+	port[2] = (value & ~En) | _backlightval;
+	return 3;
+}
+
+void LiquidCrystal_I2C::expanderWrite(uint8_t _data){                                        
+#ifdef LCD_I2C_QUEUE
+	I2CTxQueue::write(_Addr, _data | _backlightval);
+#else
+	Wire.beginTransmission(_Addr);
+	printIIC((int)(_data) | _backlightval);
+	Wire.endTransmission();   
+#endif
+}
+
+void LiquidCrystal_I2C::pulseEnable(uint8_t _data){
+	expanderWrite(_data | En);	// En high
+	waitMicroseconds(1);		// enable pulse must be >450ns
+	
+	expanderWrite(_data & ~En);	// En low
+	waitMicroseconds(50);		// commands need > 37us to settle
+} 
+
+// Give the controller time to finish a command.  On the queue, every byte already takes
+// I2C_TX_BYTE_MICROS on the bus, so short waits need nothing and longer ones are padded
+// with idle port values (EN low, so the controller ignores them); waits too long to pad
+// drain the queue and delay.
+void LiquidCrystal_I2C::waitMicroseconds(unsigned long us){
+#ifdef LCD_I2C_QUEUE
+	if (us <= I2C_TX_BYTE_MICROS) {
+		return;
+	}
+	if (us > 10000) {
+		I2CTxQueue::flush();
+		delay(us / 1000);
+		return;
+	}
+	for (unsigned long padded = I2C_TX_BYTE_MICROS; padded < us; padded += I2C_TX_BYTE_MICROS) {
+		expanderWrite(0);
+	}
+#else
+	if (us > 10000) {
+		delay(us / 1000);
+	}
+	else {
+		delayMicroseconds(us);
+	}
+#endif
+}
+
+
+// Alias functions
+
+void LiquidCrystal_I2C::cursor_on(){
+	cursor();
+}
+
+void LiquidCrystal_I2C::cursor_off(){
+	noCursor();
+}
+
+void LiquidCrystal_I2C::blink_on(){
+	blink();
+}
+
+void LiquidCrystal_I2C::blink_off(){
+	noBlink();
+}
+
+void LiquidCrystal_I2C::load_custom_character(uint8_t char_num, uint8_t *rows){
+		createChar(char_num, rows);
+}
+
+void LiquidCrystal_I2C::setBacklight(uint8_t new_val){
+	if(new_val){
+		backlight();		// turn backlight on
+	}else{
+		noBacklight();		// turn backlight off
+	}
+}
+
+void LiquidCrystal_I2C::printstr(const char c[]){
+	//This function is not identical to the function used for "real" I2C displays
+	//it's here so the user sketch doesn't have to be changed 
+	print(c);
+}
+
+
+// unsupported API functions
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+void LiquidCrystal_I2C::off(){}
+void LiquidCrystal_I2C::on(){}
+void LiquidCrystal_I2C::setDelay (int cmdDelay,int charDelay) {}
+uint8_t LiquidCrystal_I2C::status(){return 0;}
+uint8_t LiquidCrystal_I2C::keypad (){return 0;}
+uint8_t LiquidCrystal_I2C::init_bargraph(uint8_t graphtype){return 0;}
+void LiquidCrystal_I2C::draw_horizontal_graph(uint8_t row, uint8_t column, uint8_t len,  uint8_t pixel_col_end){}
+void LiquidCrystal_I2C::draw_vertical_graph(uint8_t row, uint8_t column, uint8_t len,  uint8_t pixel_row_end){}
+void LiquidCrystal_I2C::setContrast(uint8_t new_val){}
+#pragma GCC diagnostic pop
+	
@@ -0,0 +1,58 @@
+/*
+    Arduino.cpp (SimHardware)
+    2026-10-17
+
+    Arduino core functions for the native build, forwarded to the active SimBoard
+*/
+
+#include "Arduino.h"
+
+#include "sim_board.h"
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  SimBoard::active().pinMode(pin, mode);
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+  SimBoard::active().digitalWrite(pin, value);
+}
+
+int digitalRead(uint8_t pin) {
+  return SimBoard::active().digitalRead(pin);
+}
+
+int analogRead(uint8_t pin) {
+  return SimBoard::active().analogRead(pin);
+}
+
+void analogWrite(uint8_t pin, int value) {
+  SimBoard::active().analogWrite(pin, value);
+}
+
+unsigned long millis(void) {
+  return SimBoard::active().millis();
+}
+
+unsigned long micros(void) {
+  return SimBoard::active().micros();
+}
+
+void delay(unsigned long ms) {
+  SimBoard::active().advanceMillis(ms);
+}
+
+void delayMicroseconds(unsigned int us) {
+  SimBoard::active().advanceMicros(us);
+}
+
+void tone(uint8_t pin, unsigned int frequency, unsigned long duration) {
+  SimBoard::active().tone(pin, frequency, duration);
+}
+
+void noTone(uint8_t pin) {
+  SimBoard::active().noTone(pin);
+}
+
+long map(long x, long in_min, long in_max, long out_min, long out_max) {
+  return (x - in_min) * (out_max - out_min) / (in_max - in_min) + out_min;
+}
@@ -0,0 +1,31 @@
+/*
+    EEPROM.cpp (SimHardware)
+    2026-10-17
+
+    Host-side EEPROM: the byte API of the AVR core's EEPROM library, on the active SimBoard's
+        EEPROM
+*/
+
+#include "EEPROM.h"
+
+#include "sim_board.h"
+
+EEPROMClass EEPROM;
+
+uint8_t EEPROMClass::read(int address) {
+  return SimBoard::active().eepromRead(address);
+}
+
+void EEPROMClass::write(int address, uint8_t value) {
+  SimBoard::active().eepromWrite(address, value);
+}
+
+void EEPROMClass::update(int address, uint8_t value) {
+  if (read(address) != value) {
+    write(address, value);
+  }
+}
+
+uint16_t EEPROMClass::length(void) {
+  return simEEPROMSize;
+}
@@ -0,0 +1,24 @@
+/*
+    EEPROM.h (SimHardware)
+    2026-10-17
+
+    Host-side EEPROM: the byte API of the AVR core's EEPROM library, on the active SimBoard's
+        EEPROM
+*/
+
+#ifndef EEPROM_h
+#define EEPROM_h
+
+#include <stdint.h>
+
+class EEPROMClass {
+public:
+  uint8_t read(int address);
+  void write(int address, uint8_t value);
+  void update(int address, uint8_t value); // writes only if the value differs
+  uint16_t length(void);
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
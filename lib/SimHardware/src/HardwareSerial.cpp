@@ -0,0 +1,33 @@
+/*
+    HardwareSerial.cpp (SimHardware)
+    2026-10-17
+
+    Host-side Serial: everything written is captured by the active SimBoard
+*/
+
+#include "HardwareSerial.h"
+
+#include "sim_board.h"
+
+HardwareSerial Serial;
+
+void HardwareSerial::begin(unsigned long baud) {
+  (void)baud;
+}
+
+void HardwareSerial::end(void) {
+}
+
+size_t HardwareSerial::write(uint8_t value) {
+  SimBoard::active().serialWrite(value);
+  return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t *buffer, size_t size) {
+  SimBoard::active().serialWrite(buffer, size);
+  return size;
+}
+
+int HardwareSerial::availableForWrite(void) {
+  return 63; // the host never backs up, so the AVR TX buffer always looks empty
+}
@@ -0,0 +1,29 @@
+/*
+    HardwareSerial.h (SimHardware)
+    2026-10-17
+
+    Host-side Serial: everything written is captured by the active SimBoard
+*/
+
+#ifndef HardwareSerial_h
+#define HardwareSerial_h
+
+#include "Print.h"
+
+class HardwareSerial : public Print {
+public:
+  void begin(unsigned long baud);
+  void end(void);
+  operator bool(void) {
+    return true;
+  }
+
+  virtual size_t write(uint8_t value);
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  virtual int availableForWrite(void);
+  using Print::write;
+};
+
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,86 @@
+/*
+    Print.h (SimHardware)
+    2026-10-17
+
+    Host-side copy of the Arduino Print base class
+    Same virtual interface as the AVR core, so LiquidCrystal_I2C and HardwareSerial
+        dispatch exactly as they do on the board
+*/
+
+#ifndef Print_h
+#define Print_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+class __FlashStringHelper;
+
+class Print {
+public:
+  Print(void) :
+      _writeError(0) {
+  }
+  virtual ~Print(void) {
+  }
+
+  int getWriteError(void) {
+    return _writeError;
+  }
+  void clearWriteError(void) {
+    setWriteError(0);
+  }
+
+  virtual size_t write(uint8_t) = 0;
+  size_t write(const char *str) {
+    if (str == NULL) {
+      return 0;
+    }
+    return write((const uint8_t *)str, strlen(str));
+  }
+  virtual size_t write(const uint8_t *buffer, size_t size);
+  size_t write(const char *buffer, size_t size) {
+    return write((const uint8_t *)buffer, size);
+  }
+
+  virtual int availableForWrite(void) {
+    return 0;
+  }
+
+  size_t print(const __FlashStringHelper *);
+  size_t print(const char[]);
+  size_t print(char);
+  size_t print(unsigned char, int = 10);
+  size_t print(int, int = 10);
+  size_t print(unsigned int, int = 10);
+  size_t print(long, int = 10);
+  size_t print(unsigned long, int = 10);
+  size_t print(double, int = 2);
+
+  size_t println(const __FlashStringHelper *);
+  size_t println(const char[]);
+  size_t println(char);
+  size_t println(unsigned char, int = 10);
+  size_t println(int, int = 10);
+  size_t println(unsigned int, int = 10);
+  size_t println(long, int = 10);
+  size_t println(unsigned long, int = 10);
+  size_t println(double, int = 2);
+  size_t println(void);
+
+  virtual void flush(void) {
+  }
+
+protected:
+  void setWriteError(int err = 1) {
+    _writeError = err;
+  }
+
+private:
+  size_t printNumber(unsigned long, uint8_t);
+  size_t printFloat(double, uint8_t);
+
+  int _writeError;
+};
+
+#endif
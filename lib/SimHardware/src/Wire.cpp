@@ -0,0 +1,85 @@
+/*
+    Wire.cpp (SimHardware)
+    2026-10-17
+
+    Host-side TwoWire, see Wire.h
+*/
+
+#include "Wire.h"
+
+#include "sim_board.h"
+
+TwoWire Wire;
+
+TwoWire::TwoWire(void) {
+  _txAddress = 0;
+  _txLength = 0;
+  _transmitting = false;
+}
+
+void TwoWire::begin(void) {
+  _txLength = 0;
+  _transmitting = false;
+}
+
+void TwoWire::end(void) {
+}
+
+void TwoWire::setClock(uint32_t clock) {
+  (void)clock;
+}
+
+void TwoWire::beginTransmission(uint8_t address) {
+  _transmitting = true;
+  _txAddress = address;
+  _txLength = 0;
+}
+
+void TwoWire::beginTransmission(int address) {
+  beginTransmission((uint8_t)address);
+}
+
+// same return codes as the AVR library: 0 success, 2 NACK on address
+uint8_t TwoWire::endTransmission(uint8_t sendStop) {
+  (void)sendStop;
+  bool acked = SimBoard::active().i2cTransmit(_txAddress, _txBuffer, _txLength);
+  _txLength = 0;
+  _transmitting = false;
+  return acked ? 0 : 2;
+}
+
+uint8_t TwoWire::endTransmission(void) {
+  return endTransmission(true);
+}
+
+uint8_t TwoWire::requestFrom(uint8_t address, uint8_t quantity) {
+  (void)address;
+  (void)quantity;
+  return 0; // no simulated device answers reads
+}
+
+size_t TwoWire::write(uint8_t data) {
+  if (!_transmitting || _txLength >= BUFFER_LENGTH) {
+    setWriteError();
+    return 0;
+  }
+  _txBuffer[_txLength++] = data;
+  return 1;
+}
+
+size_t TwoWire::write(const uint8_t *data, size_t quantity) {
+  for (size_t i = 0; i < quantity; i++) {
+    if (!write(data[i])) {
+      return i;
+    }
+  }
+  return quantity;
+}
+
+int TwoWire::available(void) {
+  return 0;
+}
+
+int TwoWire::read(void) {
+  return -1;
+}
@@ -0,0 +1,58 @@
+/*
+    Wire.h (SimHardware)
+    2026-10-17
+
+    Host-side TwoWire: write transactions are delivered to the SimI2CDevice attached
+        at the addressed slot of the active SimBoard
+    Keeps the AVR library's 32 byte transmit buffer so transaction sizes match the board
+*/
+
+#ifndef TwoWire_h
+#define TwoWire_h
+
+#include <inttypes.h>
+
+#include "Print.h"
+
+#define BUFFER_LENGTH 32
+
+class TwoWire : public Print {
+public:
+  TwoWire(void);
+  void begin(void);
+  void end(void);
+  void setClock(uint32_t clock);
+  void beginTransmission(uint8_t address);
+  void beginTransmission(int address);
+  uint8_t endTransmission(void);
+  uint8_t endTransmission(uint8_t sendStop);
+  uint8_t requestFrom(uint8_t address, uint8_t quantity);
+  virtual size_t write(uint8_t data);
+  virtual size_t write(const uint8_t *data, size_t quantity);
+  int available(void);
+  int read(void);
+
+  inline size_t write(unsigned long n) {
+    return write((uint8_t)n);
+  }
+  inline size_t write(long n) {
+    return write((uint8_t)n);
+  }
+  inline size_t write(unsigned int n) {
+    return write((uint8_t)n);
+  }
+  inline size_t write(int n) {
+    return write((uint8_t)n);
+  }
+  using Print::write;
+
+private:
+  uint8_t _txAddress;
+  uint8_t _txBuffer[BUFFER_LENGTH];
+  uint8_t _txLength;
+  bool _transmitting;
+};
+
+extern TwoWire Wire;
+
+#endif
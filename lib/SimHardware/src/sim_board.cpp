@@ -0,0 +1,499 @@
+/*
+    sim_board.cpp
+    2026-10-17
+
+    Simulated ATmega2560 board for the native build
+    Design notes are in the .h file
+*/
+
+#include "sim_board.h"
+
+#include <atomic>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Arduino.h"
+
+static thread_local SimBoard *activeBoard = NULL;
+
+SimBoard &SimBoard::active(void) {
+  if (activeBoard == NULL) {
+    static SimBoard defaultBoard;
+    return defaultBoard;
+  }
+  return *activeBoard;
+}
+
+void SimBoard::activate(SimBoard *board) {
+  activeBoard = board;
+}
+
+SimBoard::Scope::Scope(SimBoard &board) {
+  _previous = activeBoard;
+  activeBoard = &board;
+}
+
+SimBoard::Scope::~Scope(void) {
+  activeBoard = _previous;
+}
+
+SimBoard::SimBoard(void) {
+  memset(_mode, INPUT, sizeof(_mode));
+  memset(_output, LOW, sizeof(_output));
+  memset(_driven, -1, sizeof(_driven));
+  memset(_pwm, 0, sizeof(_pwm));
+  memset(_analog, 0, sizeof(_analog));
+  memset(_toneFrequency, 0, sizeof(_toneFrequency));
+  memset(_toneEnd, 0, sizeof(_toneEnd));
+  _tones = 0;
+
+  _i2cDevices = 0;
+  memset(&_i2cStats, 0, sizeof(_i2cStats));
+  _modelBusTime = true;
+
+  _sources = 0;
+  _pinChangeHandler = NULL;
+  _analogChangeHandler = NULL;
+  _watchCount = 0;
+  memset(_reportedLevel, -1, sizeof(_reportedLevel));
+  memset(_seenByInputs, false, sizeof(_seenByInputs));
+
+  _micros = 0;
+  _autoAdvance = 0;
+  _timers = 0;
+  _inTimer = false;
+
+  memset(_eeprom, 0xFF, sizeof(_eeprom));
+  memset(_eepromWear, 0, sizeof(_eepromWear));
+  _eepromWrites = 0;
+  _eepromBusyUntil = 0;
+
+  _digitalReads = 0;
+  _digitalWrites = 0;
+  _analogReads = 0;
+
+  memset(_local, 0, sizeof(_local));
+  memset(_localDelete, 0, sizeof(_localDelete));
+}
+
+SimBoard::~SimBoard(void) {
+  for (uint8_t slot = 0; slot < simMaxLocals; slot++) {
+    if (_local[slot] != NULL) {
+      _localDelete[slot](_local[slot]);
+    }
+  }
+  if (activeBoard == this) {
+    activeBoard = NULL;
+  }
+}
+
+// one per type, for every board; a program only has a handful of types
+uint8_t SimBoard::newLocalSlot(void) {
+  static std::atomic<uint8_t> slots(0);
+  uint8_t slot = slots++;
+  if (slot >= simMaxLocals) {
+    fprintf(stderr, "SimBoard: more than %u local types\n", simMaxLocals);
+    abort();
+  }
+  return slot;
+}
+
+// virtual clock
+unsigned long SimBoard::micros(void) {
+  if (_autoAdvance != 0) { // advance(0) would find every timer already run
+    advance(_autoAdvance);
+  }
+  return _micros;
+}
+
+unsigned long SimBoard::millis(void) {
+  return micros() / 1000;
+}
+
+void SimBoard::advanceMicros(unsigned long us) {
+  advance(us);
+}
+
+void SimBoard::advanceMillis(unsigned long ms) {
+  advance(ms * 1000);
+}
+
+// every clock movement comes through here, so timers fire wherever time passes
+void SimBoard::advance(unsigned long us) {
+  if (_inTimer) {
+    _micros += us;
+    return;
+  }
+  unsigned long target = _micros + us;
+  while (_timers > 0) {
+    uint8_t next = 0;
+    for (uint8_t i = 1; i < _timers; i++) {
+      if ((long)(_timerDue[i] - _timerDue[next]) < 0) {
+        next = i;
+      }
+    }
+    if ((long)(target - _timerDue[next]) < 0) {
+      break;
+    }
+    if ((long)(_timerDue[next] - _micros) > 0) {
+      _micros = _timerDue[next];
+    }
+    _timerDue[next] += _timerPeriod[next];
+    _inTimer = true;
+    _timerHandler[next]();
+    _inTimer = false;
+    if ((long)(_micros - target) > 0) {
+      target = _micros; // time the handler itself took
+    }
+  }
+  _micros = target;
+}
+
+bool SimBoard::attachTimer(unsigned long periodMicros, SimTimerHandler handler) {
+  for (uint8_t i = 0; i < _timers; i++) {
+    if (_timerHandler[i] == handler) {
+      return true;
+    }
+  }
+  if (_timers >= simMaxTimers || periodMicros == 0) {
+    return false;
+  }
+  _timerHandler[_timers] = handler;
+  _timerPeriod[_timers] = periodMicros;
+  _timerDue[_timers] = _micros + periodMicros;
+  _timers++;
+  return true;
+}
+
+void SimBoard::detachTimer(SimTimerHandler handler) {
+  for (uint8_t i = 0; i < _timers; i++) {
+    if (_timerHandler[i] == handler) {
+      _timers--;
+      _timerHandler[i] = _timerHandler[_timers];
+      _timerPeriod[i] = _timerPeriod[_timers];
+      _timerDue[i] = _timerDue[_timers];
+      return;
+    }
+  }
+}
+
+void SimBoard::setAutoAdvance(unsigned long microsPerRead) {
+  _autoAdvance = microsPerRead;
+}
+
+void SimBoard::setModelBusTime(bool model) {
+  _modelBusTime = model;
+}
+
+// digital pins
+void SimBoard::pinMode(uint8_t pin, uint8_t mode) {
+  if (pin >= simPinCount) {
+    return;
+  }
+  uint8_t mode0 = _mode[pin];
+  uint8_t output0 = _output[pin];
+  _mode[pin] = mode;
+  // as on the AVR, INPUT_PULLUP sets the output latch and INPUT clears it
+  if (mode == INPUT_PULLUP) {
+    _output[pin] = HIGH;
+  }
+  else if (mode == INPUT) {
+    _output[pin] = LOW;
+  }
+  if (_seenByInputs[pin] && (_mode[pin] != mode0 || _output[pin] != output0)) {
+    reportPinChanges();
+  }
+}
+
+uint8_t SimBoard::pinModeOf(uint8_t pin) const {
+  return pin < simPinCount ? _mode[pin] : INPUT;
+}
+
+void SimBoard::digitalWrite(uint8_t pin, uint8_t value) {
+  _digitalWrites++;
+  if (pin >= simPinCount) {
+    return;
+  }
+  uint8_t mode0 = _mode[pin];
+  uint8_t output0 = _output[pin];
+  _output[pin] = value ? HIGH : LOW;
+  _pwm[pin] = 0;
+  if (_mode[pin] == INPUT && value) {
+    _mode[pin] = INPUT_PULLUP; // writing HIGH to an input enables the pullup
+  }
+  else if (_mode[pin] == INPUT_PULLUP && !value) {
+    _mode[pin] = INPUT;
+  }
+  if (_seenByInputs[pin] && (_mode[pin] != mode0 || _output[pin] != output0)) {
+    reportPinChanges();
+  }
+}
+
+int SimBoard::digitalRead(uint8_t pin) const {
+  _digitalReads++;
+  return inputLevel(pin);
+}
+
+// what the pin reads, without counting a read
+int SimBoard::inputLevel(uint8_t pin) const {
+  if (pin >= simPinCount) {
+    return LOW;
+  }
+  for (uint8_t i = 0; i < _sources; i++) {
+    int level;
+    if (_source[i]->read(*this, pin, level)) {
+      return level;
+    }
+  }
+  if (_driven[pin] >= 0) {
+    return _driven[pin];
+  }
+  if (_mode[pin] == OUTPUT) {
+    return _output[pin];
+  }
+  return _mode[pin] == INPUT_PULLUP ? HIGH : LOW; // unconnected inputs are taken to be pulled down
+}
+
+int SimBoard::outputLevel(uint8_t pin) const {
+  return pin < simPinCount ? _output[pin] : LOW;
+}
+
+void SimBoard::setInput(uint8_t pin, int level) {
+  driveInput(pin, level ? HIGH : LOW);
+}
+
+void SimBoard::releaseInput(uint8_t pin) {
+  driveInput(pin, -1);
+}
+
+void SimBoard::driveInput(uint8_t pin, int8_t driven) {
+  if (pin >= simPinCount || _driven[pin] == driven) {
+    return;
+  }
+  _driven[pin] = driven;
+  reportPinChanges();
+}
+
+void SimBoard::attachInputSource(SimInputSource *source) {
+  if (_sources < simMaxInputSources) {
+    _source[_sources++] = source;
+    source->_board = this;
+    for (uint8_t pin = 0; pin < simPinCount; pin++) {
+      _seenByInputs[pin] = _seenByInputs[pin] || source->readsOutput(pin);
+    }
+  }
+}
+
+void SimInputSource::changed(void) {
+  if (_board != NULL) {
+    _board->reportPinChanges();
+  }
+}
+
+void SimBoard::setPinChangeHandler(SimPinChangeHandler handler) {
+  _pinChangeHandler = handler;
+}
+
+void SimBoard::watchPin(uint8_t pin) {
+  if (pin >= simPinCount || _reportedLevel[pin] >= 0) {
+    return;
+  }
+  _watched[_watchCount++] = pin;
+  _reportedLevel[pin] = inputLevel(pin);
+  _seenByInputs[pin] = true;
+}
+
+// only watched pins are re-read, so boards nobody watches pay nothing
+void SimBoard::reportPinChanges(void) {
+  if (_pinChangeHandler == NULL) {
+    return;
+  }
+  for (uint8_t i = 0; i < _watchCount; i++) {
+    uint8_t pin = _watched[i];
+    int level = inputLevel(pin);
+    if (level != _reportedLevel[pin]) {
+      _reportedLevel[pin] = level;
+      _pinChangeHandler(pin, level);
+    }
+  }
+}
+
+// analog
+void SimBoard::setAnalogInput(uint8_t channel, int value) {
+  if (channel >= simFirstAnalogPin) {
+    channel -= simFirstAnalogPin;
+  }
+  if (channel < simAnalogChannels) {
+    value = constrain(value, 0, 1023);
+    if (_analogChangeHandler != NULL && value != _analog[channel]) {
+      _analogChangeHandler();
+    }
+    _analog[channel] = value;
+  }
+}
+
+void SimBoard::setAnalogChangeHandler(SimAnalogChangeHandler handler) {
+  _analogChangeHandler = handler;
+}
+
+int SimBoard::analogRead(uint8_t pin) {
+  _analogReads++;
+  if (pin >= simFirstAnalogPin) {
+    pin -= simFirstAnalogPin;
+  }
+  return pin < simAnalogChannels ? _analog[pin] : 0;
+}
+
+void SimBoard::analogWrite(uint8_t pin, int value) {
+  if (pin >= simPinCount) {
+    return;
+  }
+  _mode[pin] = OUTPUT;
+  if (value <= 0) {
+    digitalWrite(pin, LOW);
+  }
+  else if (value >= 255) {
+    digitalWrite(pin, HIGH);
+  }
+  else {
+    _output[pin] = HIGH;
+    _pwm[pin] = value;
+  }
+}
+
+int SimBoard::pwmDuty(uint8_t pin) const {
+  if (pin >= simPinCount) {
+    return 0;
+  }
+  if (_pwm[pin] > 0) {
+    return _pwm[pin];
+  }
+  return _output[pin] ? 255 : 0;
+}
+
+// tone
+void SimBoard::tone(uint8_t pin, unsigned int frequency, unsigned long duration) {
+  if (pin >= simPinCount) {
+    return;
+  }
+  _tones++;
+  _toneFrequency[pin] = frequency;
+  _toneEnd[pin] = duration ? _micros + duration * 1000 : 0;
+}
+
+void SimBoard::noTone(uint8_t pin) {
+  if (pin < simPinCount) {
+    _toneFrequency[pin] = 0;
+  }
+}
+
+unsigned int SimBoard::toneFrequency(uint8_t pin) {
+  if (pin >= simPinCount) {
+    return 0;
+  }
+  if (_toneEnd[pin] != 0 && _micros >= _toneEnd[pin]) {
+    _toneFrequency[pin] = 0;
+  }
+  return _toneFrequency[pin];
+}
+
+unsigned long SimBoard::toneCount(void) const {
+  return _tones;
+}
+
+// I2C
+void SimBoard::attachI2C(uint8_t address, SimI2CDevice *device) {
+  if (_i2cDevices < simMaxI2CDevices) {
+    _i2cAddress[_i2cDevices] = address;
+    _i2cDevice[_i2cDevices] = device;
+    _i2cDevices++;
+  }
+}
+
+bool SimBoard::i2cTransmit(uint8_t address, const uint8_t *data, size_t length) {
+  _i2cStats.transactions++;
+  _i2cStats.bytes += length;
+
+  // start + address byte + data bytes (9 clocks each, with ACK) + stop
+  unsigned long busMicros = ((length + 1) * 9 + 2) * 1000000L / simI2CClockHz;
+  _i2cStats.busMicros += busMicros;
+  if (_modelBusTime) {
+    advance(busMicros);
+  }
+
+  for (uint8_t i = 0; i < _i2cDevices; i++) {
+    if (_i2cAddress[i] == address) {
+      if (_i2cDevice[i]->receive(data, length)) {
+        return true;
+      }
+      break;
+    }
+  }
+  _i2cStats.nacks++;
+  return false;
+}
+
+const SimI2CStats &SimBoard::i2cStats(void) const {
+  return _i2cStats;
+}
+
+void SimBoard::resetI2CStats(void) {
+  memset(&_i2cStats, 0, sizeof(_i2cStats));
+}
+
+// Serial
+void SimBoard::serialWrite(uint8_t value) {
+  _serial.push_back((char)value);
+}
+
+void SimBoard::serialWrite(const uint8_t *data, size_t length) {
+  _serial.append((const char *)data, length);
+}
+
+std::string &SimBoard::serialOutput(void) {
+  return _serial;
+}
+
+// EEPROM
+uint8_t SimBoard::eepromRead(uint16_t address) const {
+  return address < simEEPROMSize ? _eeprom[address] : 0xFF;
+}
+
+void SimBoard::eepromWrite(uint16_t address, uint8_t value) {
+  if (address >= simEEPROMSize) {
+    return;
+  }
+  if (!eepromReady()) {
+    advance(_eepromBusyUntil - _micros);
+  }
+  _eeprom[address] = value;
+  _eepromWear[address]++;
+  _eepromWrites++;
+  _eepromBusyUntil = _micros + simEEPROMWriteMicros;
+}
+
+bool SimBoard::eepromReady(void) {
+  return (long)(micros() - _eepromBusyUntil) >= 0;
+}
+
+unsigned long SimBoard::eepromWrites(void) const {
+  return _eepromWrites;
+}
+
+unsigned long SimBoard::eepromWrites(uint16_t address) const {
+  return address < simEEPROMSize ? _eepromWear[address] : 0;
+}
+
+// counters
+unsigned long SimBoard::digitalReads(void) const {
+  return _digitalReads;
+}
+
+unsigned long SimBoard::digitalWrites(void) const {
+  return _digitalWrites;
+}
+
+unsigned long SimBoard::analogReads(void) const {
+  return _analogReads;
+}
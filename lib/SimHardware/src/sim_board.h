@@ -0,0 +1,260 @@
+/*
+    sim_board.h
+    2026-10-17
+
+    Simulated ATmega2560 board for the native build
+
+    SimBoard holds everything the Arduino API can touch: pin modes and levels, the ADC inputs,
+        PWM duty, tone generators, the I2C bus, the Serial port, the EEPROM and a virtual clock.
+        The functions in Arduino.h forward to SimBoard::active(), so the dwelling's classes
+        compile unchanged and never know they are not on the Mega.
+
+    The board is pluggable:
+        SimI2CDevice    anything answering on the I2C bus (see sim_lcd.h)
+        SimInputSource  anything that drives input pins from outside (see sim_keypad.h)
+        setInput() / setAnalogInput() drive buttons, sensors and the photoresistor directly
+        setPinChangeHandler() hears about every change of a watchPin()ed pin's level, whatever
+            caused it (setInput(), an input source, a pin mode or output change), standing in
+            for the pin change interrupts.  A mode or output change is only followed up on a
+            pin that is watched or that an input source readsOutput(), so driving the lights
+            does not re-read every input.
+        setAnalogChangeHandler() is called just before an analog input changes, so a
+            background sampler can catch up on the level being left
+
+    Time only moves when told to (advanceMicros/advanceMillis, delay(), modelled bus time),
+        so a run is deterministic and as fast as the host allows.
+    attachTimer() stands in for a timer interrupt: its handler runs at every multiple of its
+        period that time passes through, in time order with any other timers.
+    The EEPROM starts erased (0xFF) and, like the real one, outlives whatever runs on the board:
+        a second Dwelling built on the same board sees what the first wrote, as after a reset.
+        A byte write keeps it busy for simEEPROMWriteMicros; writing while busy waits it out
+        (moving the clock), as avr-libc does, and eepromReady() lets code avoid that.
+    Each thread has its own active board; Scope switches boards for a block, which lets one
+        process simulate several independent dwellings.
+    local<T>() is storage that belongs to the board, for what the firmware keeps in statics
+        because the Mega has one of it (see board_local.h): one T per board, value-initialized
+        on first use and deleted with the board.  A board can move between threads, so long as
+        only one uses it at a time.
+*/
+
+#ifndef SIM_BOARD_H
+#define SIM_BOARD_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string>
+
+class SimBoard;
+
+const uint8_t simPinCount = 70;        // Mega digital pins 0-53 plus A0-A15
+const uint8_t simAnalogChannels = 16;  // A0-A15
+const uint8_t simFirstAnalogPin = 54;  // A0
+const uint8_t simMaxI2CDevices = 4;
+const uint8_t simMaxInputSources = 4;
+const uint8_t simMaxTimers = 4;
+const unsigned long simI2CClockHz = 100000L; // Wire default
+const uint16_t simEEPROMSize = 4096;         // ATmega2560
+const unsigned long simEEPROMWriteMicros = 3400;
+const uint8_t simMaxLocals = 16; // types kept with local<T>()
+
+class SimI2CDevice {
+public:
+  virtual ~SimI2CDevice(void) {
+  }
+  // one call per write transaction; return false to NACK
+  virtual bool receive(const uint8_t *data, size_t length) = 0;
+};
+
+class SimInputSource {
+public:
+  SimInputSource(void) :
+      _board(NULL) {
+  }
+  virtual ~SimInputSource(void) {
+  }
+  // return true (and set level) if this source is currently driving pin
+  virtual bool read(const SimBoard &board, uint8_t pin, int &level) = 0;
+  // whether read() can depend on pin's mode or output; asked once, when the source is attached
+  virtual bool readsOutput(uint8_t pin) const {
+    (void)pin;
+    return true;
+  }
+
+protected:
+  // call when the levels this source drives may have changed, so watched pins are re-read
+  void changed(void);
+
+private:
+  friend class SimBoard;
+  SimBoard *_board;
+};
+
+// called when what a watched pin reads changes, as a pin change interrupt would
+typedef void (*SimPinChangeHandler)(uint8_t pin, int level);
+// called just before an analog input changes
+typedef void (*SimAnalogChangeHandler)(void);
+// called every period of a timer, as a timer interrupt would
+typedef void (*SimTimerHandler)(void);
+
+typedef struct {
+  unsigned long transactions;
+  unsigned long bytes;
+  unsigned long nacks;
+  unsigned long busMicros; // time the bus was busy at simI2CClockHz
+} SimI2CStats;
+
+class SimBoard {
+public:
+  SimBoard(void);
+  ~SimBoard(void);
+  SimBoard(const SimBoard &) = delete;
+  SimBoard &operator=(const SimBoard &) = delete;
+
+  // board the Arduino API talks to on this thread
+  static SimBoard &active(void);
+  static void activate(SimBoard *board); // NULL restores the default board
+
+  class Scope {
+  public:
+    Scope(SimBoard &board);
+    ~Scope(void);
+
+  private:
+    SimBoard *_previous;
+  };
+
+  // virtual clock
+  unsigned long micros(void);
+  unsigned long millis(void);
+  void advanceMicros(unsigned long us);
+  void advanceMillis(unsigned long ms);
+  // every clock read also moves time forward, so busy-wait loops terminate
+  void setAutoAdvance(unsigned long microsPerRead);
+  // charge I2C transfers against the virtual clock, as the blocking Wire library does
+  void setModelBusTime(bool model);
+  // false if every timer is taken; a handler already attached is not attached twice
+  bool attachTimer(unsigned long periodMicros, SimTimerHandler handler);
+  void detachTimer(SimTimerHandler handler); // safe from inside the handler
+
+  // digital pins
+  void pinMode(uint8_t pin, uint8_t mode);
+  uint8_t pinModeOf(uint8_t pin) const;
+  void digitalWrite(uint8_t pin, uint8_t value);
+  int digitalRead(uint8_t pin) const;
+  int outputLevel(uint8_t pin) const;
+  void setInput(uint8_t pin, int level);
+  void releaseInput(uint8_t pin);
+  void attachInputSource(SimInputSource *source);
+  void setPinChangeHandler(SimPinChangeHandler handler); // NULL for none
+  void watchPin(uint8_t pin);
+
+  // analog
+  void setAnalogInput(uint8_t channel, int value);
+  void setAnalogChangeHandler(SimAnalogChangeHandler handler); // NULL for none
+  int analogRead(uint8_t pin);
+  void analogWrite(uint8_t pin, int value);
+  int pwmDuty(uint8_t pin) const;
+
+  // tone
+  void tone(uint8_t pin, unsigned int frequency, unsigned long duration);
+  void noTone(uint8_t pin);
+  unsigned int toneFrequency(uint8_t pin); // 0 when silent
+  unsigned long toneCount(void) const;
+
+  // I2C
+  void attachI2C(uint8_t address, SimI2CDevice *device);
+  bool i2cTransmit(uint8_t address, const uint8_t *data, size_t length);
+  const SimI2CStats &i2cStats(void) const;
+  void resetI2CStats(void);
+
+  // Serial
+  void serialWrite(uint8_t value);
+  void serialWrite(const uint8_t *data, size_t length);
+  std::string &serialOutput(void);
+
+  // EEPROM
+  uint8_t eepromRead(uint16_t address) const;
+  void eepromWrite(uint16_t address, uint8_t value);
+  bool eepromReady(void);
+  unsigned long eepromWrites(void) const;
+  unsigned long eepromWrites(uint16_t address) const; // the wear on one cell
+
+  // the board's T, made on first use
+  template <class T> T &local(void);
+
+  // counters for profiling the code under test
+  unsigned long digitalReads(void) const;
+  unsigned long digitalWrites(void) const;
+  unsigned long analogReads(void) const;
+
+private:
+  friend class SimInputSource;
+
+  uint8_t _mode[simPinCount];
+  uint8_t _output[simPinCount];
+  int8_t _driven[simPinCount]; // -1 when not driven from outside
+  int16_t _pwm[simPinCount];
+  uint16_t _analog[simAnalogChannels];
+
+  unsigned int _toneFrequency[simPinCount];
+  unsigned long _toneEnd[simPinCount]; // 0 means no end
+  unsigned long _tones;
+
+  uint8_t _i2cAddress[simMaxI2CDevices];
+  SimI2CDevice *_i2cDevice[simMaxI2CDevices];
+  uint8_t _i2cDevices;
+  SimI2CStats _i2cStats;
+  bool _modelBusTime;
+
+  SimInputSource *_source[simMaxInputSources];
+  uint8_t _sources;
+  SimPinChangeHandler _pinChangeHandler;
+  SimAnalogChangeHandler _analogChangeHandler;
+  uint8_t _watched[simPinCount];
+  uint8_t _watchCount;
+  int8_t _reportedLevel[simPinCount];
+  bool _seenByInputs[simPinCount]; // watched, or read by an input source
+
+  unsigned long _micros;
+  unsigned long _autoAdvance;
+
+  SimTimerHandler _timerHandler[simMaxTimers];
+  unsigned long _timerPeriod[simMaxTimers];
+  unsigned long _timerDue[simMaxTimers];
+  uint8_t _timers;
+  bool _inTimer; // time moved by a handler does not run handlers
+
+  std::string _serial;
+
+  uint8_t _eeprom[simEEPROMSize];
+  unsigned long _eepromWear[simEEPROMSize];
+  unsigned long _eepromWrites;
+  unsigned long _eepromBusyUntil; // micros
+
+  void *_local[simMaxLocals];
+  void (*_localDelete[simMaxLocals])(void *);
+  static uint8_t newLocalSlot(void);
+  template <class T> static void deleteLocal(void *local) {
+    delete (T *)local;
+  }
+
+  int inputLevel(uint8_t pin) const;
+  void driveInput(uint8_t pin, int8_t driven);
+  void reportPinChanges(void);
+  void advance(unsigned long us);
+
+  mutable unsigned long _digitalReads;
+  unsigned long _digitalWrites;
+  unsigned long _analogReads;
+};
+
+template <class T> T &SimBoard::local(void) {
+  static const uint8_t slot = newLocalSlot();
+  if (_local[slot] == NULL) {
+    _local[slot] = new T();
+    _localDelete[slot] = deleteLocal<T>;
+  }
+  return *(T *)_local[slot];
+}
+
+#endif
@@ -0,0 +1,83 @@
+/*
+    sim_keypad.cpp
+    2026-10-17
+
+    Simulated matrix keypad
+    Design notes are in the .h file
+*/
+
+#include "sim_keypad.h"
+
+#include "Arduino.h"
+
+SimKeypadMatrix::SimKeypadMatrix(const char *keymap, const uint8_t *rowPins, const uint8_t *columnPins, uint8_t rows,
+                                 uint8_t columns) {
+  _keymap = keymap;
+  _rowPins = rowPins;
+  _columnPins = columnPins;
+  _rows = rows;
+  _columns = columns;
+  releaseAll();
+}
+
+int SimKeypadMatrix::find(char key) const {
+  for (int i = 0; i < _rows * _columns && i < simKeypadMaxKeys; i++) {
+    if (_keymap[i] == key) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+bool SimKeypadMatrix::press(char key) {
+  int index = find(key);
+  if (index < 0) {
+    return false;
+  }
+  _pressed[index] = true;
+  changed();
+  return true;
+}
+
+bool SimKeypadMatrix::release(char key) {
+  int index = find(key);
+  if (index < 0) {
+    return false;
+  }
+  _pressed[index] = false;
+  changed();
+  return true;
+}
+
+void SimKeypadMatrix::releaseAll(void) {
+  for (uint8_t i = 0; i < simKeypadMaxKeys; i++) {
+    _pressed[i] = false;
+  }
+  changed();
+}
+
+bool SimKeypadMatrix::readsOutput(uint8_t pin) const {
+  for (uint8_t c = 0; c < _columns; c++) {
+    if (_columnPins[c] == pin) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool SimKeypadMatrix::read(const SimBoard &board, uint8_t pin, int &level) {
+  for (uint8_t r = 0; r < _rows; r++) {
+    if (_rowPins[r] != pin) {
+      continue;
+    }
+    for (uint8_t c = 0; c < _columns; c++) {
+      if (_pressed[r * _columns + c] && board.pinModeOf(_columnPins[c]) == OUTPUT &&
+          board.outputLevel(_columnPins[c]) == LOW) {
+        level = LOW;
+        return true;
+      }
+    }
+    return false;
+  }
+  return false;
+}
@@ -0,0 +1,45 @@
+/*
+    sim_keypad.h
+    2026-10-17
+
+    Simulated matrix keypad for the native build
+
+    Wired like the real panel: a pressed key connects its row pin to its column pin.
+        A row reads LOW while any pressed key in it sits on a column that is being driven LOW,
+        which is exactly what Keypad::scanKeys() looks for.
+    Keys are pressed and released by character, using the same keymap the Keypad gets.
+*/
+
+#ifndef SIM_KEYPAD_H
+#define SIM_KEYPAD_H
+
+#include <stdint.h>
+
+#include "sim_board.h"
+
+const uint8_t simKeypadMaxKeys = 16;
+
+class SimKeypadMatrix : public SimInputSource {
+public:
+  SimKeypadMatrix(const char *keymap, const uint8_t *rowPins, const uint8_t *columnPins, uint8_t rows,
+                  uint8_t columns);
+
+  bool press(char key);
+  bool release(char key);
+  void releaseAll(void);
+
+  virtual bool read(const SimBoard &board, uint8_t pin, int &level);
+  virtual bool readsOutput(uint8_t pin) const; // the column pins
+
+private:
+  int find(char key) const;
+
+  const char *_keymap;
+  const uint8_t *_rowPins;
+  const uint8_t *_columnPins;
+  uint8_t _rows;
+  uint8_t _columns;
+  bool _pressed[simKeypadMaxKeys];
+};
+
+#endif
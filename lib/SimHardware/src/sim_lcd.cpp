@@ -0,0 +1,130 @@
+/*
+    sim_lcd.cpp
+    2026-10-17
+
+    Simulated HD44780 LCD on a PCF8574 backpack
+    Design notes are in the .h file
+*/
+
+#include "sim_lcd.h"
+
+#include <string.h>
+
+const uint8_t expanderRS = 0x01;
+const uint8_t expanderEN = 0x04;
+const uint8_t expanderBacklight = 0x08;
+
+const uint8_t rowOffsets[] = {0x00, 0x40, 0x14, 0x54};
+
+SimLCD::SimLCD(uint8_t columns, uint8_t rows) {
+  _columns = columns;
+  _rows = rows;
+  memset(_ddram, ' ', sizeof(_ddram));
+  _address = 0;
+  _increment = true;
+  _fourBit = false;
+  _haveHighNibble = false;
+  _highNibble = 0;
+  _cgram = false;
+  _displayOn = false;
+  _backlight = false;
+  _port = 0;
+  _commands = 0;
+  _characters = 0;
+}
+
+bool SimLCD::receive(const uint8_t *data, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    expander(data[i]);
+  }
+  return true;
+}
+
+void SimLCD::expander(uint8_t value) {
+  bool enableFell = (_port & expanderEN) && !(value & expanderEN);
+  if (enableFell) {
+    // the controller samples the bus as EN drops, i.e. the levels held while EN was high
+    nibble(_port & 0xF0, _port & expanderRS);
+  }
+  _backlight = value & expanderBacklight;
+  _port = value;
+}
+
+void SimLCD::nibble(uint8_t value, bool data) {
+  if (!_fourBit) {
+    execute(value, data); // 8 bit mode: D0-D3 are not wired and read as 0
+    return;
+  }
+  if (!_haveHighNibble) {
+    _highNibble = value;
+    _haveHighNibble = true;
+    return;
+  }
+  _haveHighNibble = false;
+  execute(_highNibble | (value >> 4), data);
+}
+
+void SimLCD::execute(uint8_t value, bool data) {
+  if (data) {
+    _characters++;
+    if (!_cgram) {
+      _ddram[_address & 0x7F] = value;
+      _address = (_address + (_increment ? 1 : -1)) & 0x7F;
+    }
+    return;
+  }
+
+  _commands++;
+  if (value & 0x80) { // set DDRAM address
+    _address = value & 0x7F;
+    _cgram = false;
+  }
+  else if (value & 0x40) { // set CGRAM address
+    _cgram = true;
+  }
+  else if (value & 0x20) { // function set
+    _fourBit = !(value & 0x10);
+    _haveHighNibble = false;
+  }
+  else if (value & 0x10) { // cursor / display shift: display contents are unaffected
+  }
+  else if (value & 0x08) { // display control
+    _displayOn = value & 0x04;
+  }
+  else if (value & 0x04) { // entry mode
+    _increment = value & 0x02;
+  }
+  else if (value & 0x02) { // return home
+    _address = 0;
+    _cgram = false;
+  }
+  else if (value & 0x01) { // clear
+    memset(_ddram, ' ', sizeof(_ddram));
+    _address = 0;
+    _increment = true;
+    _cgram = false;
+  }
+}
+
+std::string SimLCD::text(uint8_t row) const {
+  if (row >= _rows || row >= sizeof(rowOffsets)) {
+    return std::string();
+  }
+  return std::string((const char *)&_ddram[rowOffsets[row]], _columns);
+}
+
+bool SimLCD::backlight(void) const {
+  return _backlight;
+}
+
+bool SimLCD::displayOn(void) const {
+  return _displayOn;
+}
+
+unsigned long SimLCD::commands(void) const {
+  return _commands;
+}
+
+unsigned long SimLCD::characters(void) const {
+  return _characters;
+}
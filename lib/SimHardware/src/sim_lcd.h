@@ -0,0 +1,58 @@
+/*
+    sim_lcd.h
+    2026-10-17
+
+    Simulated 16x2 HD44780 character LCD behind a PCF8574 I2C backpack,
+        as driven by LiquidCrystal_I2C
+
+    Each byte written to the expander is a port value:
+        P0 = RS, P1 = RW, P2 = EN, P3 = backlight, P4-P7 = D4-D7
+    A nibble is latched on the falling edge of EN.  The controller starts in 8 bit mode and
+        follows the function set commands, so the library's reset sequence works as on the panel.
+*/
+
+#ifndef SIM_LCD_H
+#define SIM_LCD_H
+
+#include <stdint.h>
+#include <string>
+
+#include "sim_board.h"
+
+class SimLCD : public SimI2CDevice {
+public:
+  SimLCD(uint8_t columns, uint8_t rows);
+
+  virtual bool receive(const uint8_t *data, size_t length);
+
+  // what the panel currently shows on row, padded to the column count
+  std::string text(uint8_t row) const;
+  bool backlight(void) const;
+  bool displayOn(void) const;
+
+  unsigned long commands(void) const;
+  unsigned long characters(void) const;
+
+private:
+  void expander(uint8_t value);
+  void nibble(uint8_t value, bool data);
+  void execute(uint8_t value, bool data);
+
+  uint8_t _columns;
+  uint8_t _rows;
+  uint8_t _ddram[0x80];
+  uint8_t _address;
+  bool _increment;
+  bool _fourBit;
+  bool _haveHighNibble;
+  uint8_t _highNibble;
+  bool _cgram;
+  bool _displayOn;
+  bool _backlight;
+  uint8_t _port;
+
+  unsigned long _commands;
+  unsigned long _characters;
+};
+
+#endif
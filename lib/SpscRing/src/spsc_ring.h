@@ -0,0 +1,169 @@
+/*
+    spsc_ring.h
+    2026-10-17
+
+    Lock-free single producer, single consumer ring buffer
+
+    One side (an interrupt, or a thread on the host) only calls push(); the other (the main loop)
+        only calls pop() and drop().  Neither ever disables interrupts or waits for the other:
+        each index is written by one side only, and read by the other.
+        head    next slot to fill, written by the producer after the record is in place
+        tail    next slot to take, written by the consumer after the record is copied out
+    The indices are single bytes that run freely and wrap at 256, so a load or store of one is a
+        single instruction on the 8 bit AVR, and head - tail is the count even across the wrap.
+        size must be a power of two no larger than 128, and every slot is usable.
+    Ordering: on the AVR the core never reorders memory, so only the compiler has to be kept
+        from moving record accesses across an index update (a memory clobber).  On the host the
+        indices are stored with release and loaded with acquire semantics.
+
+    push() on a full ring drops the record and counts it in overflows(); a producer that would
+        rather wait checks full() first.  The array forms of push() and pop() move a run of
+        records with a single index update: push() takes all of them or none.
+
+    EventRecord is the usual record: when it happened, where from, and what.
+*/
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+#include <stdint.h>
+
+#ifdef __AVR__
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#endif
+
+template <class Payload> struct EventRecord {
+  unsigned long millis;
+  uint8_t source;
+  Payload payload;
+};
+
+// the other side's index
+static inline uint8_t spscLoadAcquire(const uint8_t &index) {
+#ifdef __AVR__
+  uint8_t value = *(const volatile uint8_t *)&index;
+  __asm__ __volatile__("" ::: "memory");
+  return value;
+#else
+  return __atomic_load_n(&index, __ATOMIC_ACQUIRE);
+#endif
+}
+
+// this side's index, once the slot is done with
+static inline void spscStoreRelease(uint8_t &index, uint8_t value) {
+#ifdef __AVR__
+  __asm__ __volatile__("" ::: "memory");
+  *(volatile uint8_t *)&index = value;
+#else
+  __atomic_store_n(&index, value, __ATOMIC_RELEASE);
+#endif
+}
+
+template <class Record, uint8_t size> class SpscRing {
+  static_assert(size != 0 && size <= 128 && (size & (size - 1)) == 0, "ring size must be a power of two up to 128");
+
+public:
+  SpscRing(void) {
+    _head = 0;
+    _tail = 0;
+    _overflows = 0;
+  }
+
+  // producer: false, and counted, if the ring is full
+  bool push(const Record &record) {
+    uint8_t head = _head;
+    if ((uint8_t)(head - spscLoadAcquire(_tail)) == size) {
+#ifdef __AVR__
+      _overflows++;
+#else
+      __atomic_fetch_add(&_overflows, 1, __ATOMIC_RELAXED);
+#endif
+      return false;
+    }
+    _records[head & (size - 1)] = record;
+    spscStoreRelease(_head, head + 1);
+    return true;
+  }
+
+  // producer: all count records or none; false, and every record counted, if they do not fit
+  bool push(const Record *records, uint8_t count) {
+    uint8_t head = _head;
+    if ((uint8_t)(size - (uint8_t)(head - spscLoadAcquire(_tail))) < count) {
+#ifdef __AVR__
+      _overflows += count;
+#else
+      __atomic_fetch_add(&_overflows, count, __ATOMIC_RELAXED);
+#endif
+      return false;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+      _records[(uint8_t)(head + i) & (size - 1)] = records[i];
+    }
+    spscStoreRelease(_head, head + count);
+    return true;
+  }
+
+  bool full(void) const {
+    return count() == size;
+  }
+
+  // consumer: false if the ring is empty
+  bool pop(Record &record) {
+    uint8_t tail = _tail;
+    if (tail == spscLoadAcquire(_head)) {
+      return false;
+    }
+    record = _records[tail & (size - 1)];
+    spscStoreRelease(_tail, tail + 1);
+    return true;
+  }
+
+  // consumer: up to count records; returns how many were taken
+  uint8_t pop(Record *records, uint8_t count) {
+    uint8_t tail = _tail;
+    uint8_t available = spscLoadAcquire(_head) - tail;
+    if (count > available) {
+      count = available;
+    }
+    for (uint8_t i = 0; i < count; i++) {
+      records[i] = _records[(uint8_t)(tail + i) & (size - 1)];
+    }
+    spscStoreRelease(_tail, tail + count);
+    return count;
+  }
+
+  // consumer: discard everything queued so far
+  void drop(void) {
+    spscStoreRelease(_tail, spscLoadAcquire(_head));
+  }
+
+  // either side; a snapshot, which the other side may change at once
+  uint8_t count(void) const {
+    return spscLoadAcquire(_head) - spscLoadAcquire(_tail);
+  }
+
+  bool empty(void) const {
+    return count() == 0;
+  }
+
+  unsigned long overflows(void) const {
+#ifdef __AVR__
+    uint8_t sreg = SREG; // four bytes: not atomic on the AVR
+    cli();
+    unsigned long count = _overflows;
+    SREG = sreg;
+    return count;
+#else
+    return __atomic_load_n(&_overflows, __ATOMIC_RELAXED);
+#endif
+  }
+
+private:
+  Record _records[size];
+  uint8_t _head;
+  uint8_t _tail;
+  volatile unsigned long _overflows; // producer only
+};
+
+#endif
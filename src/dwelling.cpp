@@ -12,175 +12,336 @@
 
 #include "DigitalPinIO.h"
 #include "LiquidCrystal_I2C.h"
-#include "pins.h"
-
-const int interiorLightsPowerUsage = 1;
-const int exteriorLightsPowerUsage = 3;
-
-// interiorLights levels:
-const int interiorLightsCritical = 2;
-const int interiorLightsLow = 63;
-const int interiorLightsNormal = 255;
-
-// _keypad
-const byte keypadRows = 4;
-const byte keypadColumns = 4;
-
-const char keys[keypadRows][keypadColumns] = {
-    {'1', '2', '3', 'A'},
-    {'4', '5', '6', 'B'},
-    {'7', '8', '9', 'C'},
-    {'*', '0', '#', 'D'},
-};
-byte rowPins[keypadRows] = {keypad00, keypad01, keypad02, keypad03};
-byte columnPins[keypadColumns] = {keypad04, keypad05, keypad06, keypad07};
-
-Dwelling::Dwelling(void) :
-    _alarmSystem(alarmSystemPWMPin),
+#include "analog_sampler.h"
+#include "input_engine.h"
+#include "profiler.h"
+#include "state_journal.h"
+#include "telemetry.h"
+#include "tone_sequencer.h"
+
+// unlock
+const int codeLength = 6;
+const int failureLimit = 3;
+const char code[codeLength + 1] PROGMEM = {'7', '4', '5', '2', 'A', '0', 0}; // + 1 accounts for terminal 0
+const unsigned long grantedMillis = 2000;
+const unsigned long badCodeMillis = 5000;
+const unsigned long lockoutMillis = 15000;
+
+// C++11, the AVR build's, wants storage for a constexpr member that is copied
+constexpr MegaPanel::KeypadLayout MegaPanel::keypad;
+
+template <class Config>
+BasicDwelling<Config>::BasicDwelling(void) :
+    _alarmSystem(Config::alarmSystemPWMPin),
     _electricalStorage(),
-    _exteriorLights(exteriorFloodlightsPin, DigitalPinIO::highOn),
-    _interiorLights(interiorLightsPWMControlPin),
-    _intruderAlarm(intruderMotionAlarmPin, DigitalPinIO::withoutPullup, DigitalPinIO::highOn),
-    _solarArray(solarArrayAnalogInputPin),
-    _batteryStatusLight(batteryLevelLEDRedPin, batteryLevelLEDGreenPin),
-    _exteriorAlertLight(exteriorAlertLightPin, DigitalPinIO::highOn),
-    _statusDisplay(0x27, 16, 2),
-    _exteriorLightsButton(exteriorLightsButtonPin, DigitalPinIO::withPullup, DigitalPinIO::lowOn),
-    _interiorLightsButton(interiorLightsButtonPin, DigitalPinIO::withPullup, DigitalPinIO::lowOn),
-    _accessStatus(lockRedPin, lockGreenPin),
-    _keypad(makeKeymap(keys), rowPins, columnPins, keypadRows, keypadColumns) {
+    _exteriorLights(Config::exteriorFloodlightsPin, DigitalPinIO::highOn),
+    _interiorLights(Config::interiorLightsPWMControlPin),
+    _intruderAlarm(Config::intruderMotionAlarmPin, DigitalPinIO::withoutPullup, DigitalPinIO::highOn),
+    _solarArray(Config::solarArrayAnalogInputPin),
+    _batteryStatusLight(Config::batteryLevelLEDRedPin, Config::batteryLevelLEDGreenPin),
+    _exteriorAlertLight(Config::exteriorAlertLightPin, DigitalPinIO::highOn),
+    _statusDisplay(Config::statusDisplayAddress, lcdFrameColumns, lcdFrameRows),
+    _statusFrame(_statusDisplay),
+    _exteriorLightsButton(Config::exteriorLightsButtonPin, DigitalPinIO::withPullup, DigitalPinIO::lowOn),
+    _interiorLightsButton(Config::interiorLightsButtonPin, DigitalPinIO::withPullup, DigitalPinIO::lowOn),
+    _accessStatus(Config::lockRedPin, Config::lockGreenPin),
+    _keypadWiring(Config::keypad),
+    _keypad(_keypadWiring.keys, _keypadWiring.rowPins, _keypadWiring.columnPins, Config::KeypadLayout::rowCount,
+            Config::KeypadLayout::columnCount),
+    _scheduler(*this) {
+  for (uint8_t i = 0; i < dwellingTaskCount; i++) {
+    _scheduler.addTask_P(&_tasks[i]);
+  }
+
   _exteriorLightsTurnedOnManually = false;
   _unlocked = false;
+  _accessState = AccessPrompt;
+  _accessStateStarted = 0;
+  _codeCharsEntered = 0;
+  _codeMatches = true;
+  _unlockFailures = 0;
 }
 
-void Dwelling::init(void) {
+template <class Config> void BasicDwelling<Config>::init(void) {
+  // a warm boot picks up where the dwelling left off, lockout included
+  PersistentState state;
+  if (StateJournal::restore(state)) {
+    _electricalStorage.restore(state.battery, state.charging);
+    _unlockFailures = state.unlockFailures;
+  }
+
   _accessStatus.turnOnRed();
   if (_unlocked) {
     _accessStatus.turnOnGreen();
   }
+  _intruderAlarm.useInterrupts(Config::motionDebounceMillis, 0);
+  _exteriorLightsButton.useInterrupts(Config::buttonDebounceMillis, 0);
+  _interiorLightsButton.useInterrupts(Config::buttonDebounceMillis, 0);
+  _keypad.useInterrupts();
+  InputEngine::begin();
+  _solarArray.useInterrupts();
+  AnalogSampler::begin();
+
   initStatusDisplay();
+  unlock(); // put up the PIN prompt, or the lockout
+}
+
+/* Task table
+   Input events are handed out first, so every task sees presses that came and went since the
+     last tick.
+   The LCD comes up in the background over the first second or so (see initStatusDisplay()),
+     a step a tick; until it is ready everything draws into the frame buffer only.
+   Lighting and the motion detector react to people and run first, every tick; they share a
+     priority so they keep their original order (lighting has to see a button press before the
+     motion detector decides whether the floodlights were turned on manually).
+   The LCD is the heavy task: it runs last and on odd ticks only, so it never shares a tick
+     with battery accounting (every 10th tick, phase 0).
+   Telemetry runs after everything else, so its record shows the state the tick left behind.
+   The journal only notes the battery's state for the EEPROM after charging has updated it;
+     the writing itself is spread over loop()'s wake ups (see state_journal.h).
+*/
+const char inputsTaskName[] PROGMEM = "inputs";
+const char startupTaskName[] PROGMEM = "lcdStartup";
+const char lightingTaskName[] PROGMEM = "lighting";
+const char motionTaskName[] PROGMEM = "motion";
+const char accessTaskName[] PROGMEM = "access";
+const char batteryLightTaskName[] PROGMEM = "batteryLight";
+const char chargingTaskName[] PROGMEM = "charging";
+const char displayTaskName[] PROGMEM = "display";
+const char telemetryTaskName[] PROGMEM = "telemetry";
+const char journalTaskName[] PROGMEM = "journal";
+
+template <class Config>
+const ScheduledTask<BasicDwelling<Config>> BasicDwelling<Config>::_tasks[dwellingTaskCount] PROGMEM = {
+    // name, method, period (ticks), phase (tick), priority, deadline (us after tick start)
+    {inputsTaskName, &BasicDwelling::inputEvents, 1, 0, 4, 500},
+    {startupTaskName, &BasicDwelling::statusDisplayStartup, 1, 0, 4, 2000},
+    {lightingTaskName, &BasicDwelling::lighting, 1, 0, 3, 2000},
+    {motionTaskName, &BasicDwelling::exteriorMotionDetector, 1, 0, 3, 2000},
+    {accessTaskName, &BasicDwelling::accessControl, 1, 0, 2, 40000},
+    {batteryLightTaskName, &BasicDwelling::houseBatteryStatusLight, 1, 0, 1, 12000},
+    {chargingTaskName, &BasicDwelling::batteryChargingAndUsage, Config::chargingPeriodTicks, Config::chargingPhaseTick,
+     1, 15000},
+    {displayTaskName, &BasicDwelling::statusDisplays, Config::displayPeriodTicks, Config::displayPhaseTick, 0, 50000},
+    {telemetryTaskName, &BasicDwelling::telemetry, 1, 0, 0, 55000},
+    {journalTaskName, &BasicDwelling::persistState, 1, 0, 0, 60000},
+};
+
+template <class Config> void BasicDwelling<Config>::tick(TickCount tickCount) {
+  _scheduler.run(tickCount);
 }
 
-void Dwelling::tick(int tickCount) {
-  const int ticksPerLighting = 1;     // lighting input happens every tick
-  const int ticksPerMotionSensor = 1; // motion sensor checked every tick
-  const int ticksPerCharging = 10;    // charging happens every second
+template <class Config> void BasicDwelling<Config>::accessControl(TickCount /*tickCount*/) {
+  unlock();
+}
 
-  statusDisplays(tickCount);
-  houseBatteryStatusLight(tickCount);
+template <class Config> void BasicDwelling<Config>::inputEvents(TickCount /*tickCount*/) {
+  PROFILE_SCOPE(ProfileInputs);
+  DigitalPinIn::dispatchEvents();
+}
 
-  if ((tickCount % ticksPerLighting) == 0) {
-    lighting();
+template <class Config> void BasicDwelling<Config>::statusDisplayStartup(TickCount /*tickCount*/) {
+  if (_statusDisplay.ready() || !_statusDisplay.poll()) {
+    return;
   }
+  _statusDisplay.backlight();
+  _statusFrame.panelCleared();
+  _statusFrame.update(); // whatever was drawn while it came up
+}
 
-  if ((tickCount % ticksPerCharging) == 0) {
-    batteryChargingAndUsage();
+template <class Config> void BasicDwelling<Config>::telemetry(TickCount tickCount) {
+  PROFILE_SCOPE(ProfileTelemetry);
+  TelemetryTickRecord record;
+  record.tickCount = tickCount;
+  record.battery = _electricalStorage.batteryLevel();
+  record.solar = _solarArray.value();
+  record.flags = 0;
+  if (_interiorLights.isOn()) {
+    record.flags |= telemetryInteriorLights;
   }
-
-  if ((tickCount % ticksPerMotionSensor) == 0) {
-    exteriorMotionDetector(tickCount);
+  if (_exteriorLights.isOn()) {
+    record.flags |= telemetryExteriorLights;
+  }
+  if (_exteriorAlertLight.isOn()) {
+    record.flags |= telemetryAlertLight;
+  }
+  if (_intruderAlarm.isOn()) {
+    record.flags |= telemetryMotion;
+  }
+  if (_interiorLightsButton.isOn()) {
+    record.flags |= telemetryInteriorButton;
   }
+  if (_exteriorLightsButton.isOn()) {
+    record.flags |= telemetryExteriorButton;
+  }
+  if (_electricalStorage.isCharging()) {
+    record.flags |= telemetryCharging;
+  }
+  if (_unlocked) {
+    record.flags |= telemetryUnlocked;
+  }
+  if (ToneSequencer::isPlaying()) {
+    record.flags |= telemetrySounding;
+  }
+  record.alarm = _alarmSystem.signal();
+  record.powerLevel = _electricalStorage.powerLevel();
+  Telemetry::tick(record);
 }
 
-void Dwelling::unlock(void) {
-  const int codeLength = 6;
-  const int failureLimit = 3;
-  static int failures = 0;
-
-  initStatusDisplay(); // clear status display, make sure it's backlit
-  while (!_unlocked) {
-    _statusDisplay.setCursor(0, 0);
-    _statusDisplay.print("Input PIN:     ");
-    const char code[codeLength + 1] = {'7', '4', '5', '2', 'A', '0', 0}; // + 1 accounts for terminal 0
-    char input[codeLength + 1] = {' ', ' ', ' ', ' ', ' ', ' ', 0};      // + 1 accounts for terminal 0
-
-    for (int inputChars = 0; inputChars < codeLength; inputChars++) {
-      char key = _keypad.waitForKey();
-      if (key) {
-        input[inputChars] = key;
-        _statusDisplay.setCursor(10 + inputChars, 0);
-        _statusDisplay.print("*");
-      }
+template <class Config> void BasicDwelling<Config>::persistState(TickCount /*tickCount*/) {
+  PROFILE_SCOPE(ProfileJournal);
+  journalState(false);
+  StateJournal::service();
+}
+
+// now: PIN failures, which a power cycle must not be able to clear
+template <class Config> void BasicDwelling<Config>::journalState(bool now) {
+  PersistentState state;
+  state.battery = _electricalStorage.batteryLevel();
+  state.charging = _electricalStorage.isCharging();
+  state.unlockFailures = _unlockFailures;
+  StateJournal::save(state, now);
+}
+
+// PIN entry as a state machine: each call takes the keys pressed since the last one, or one
+//   expired message, so the rest of tick() keeps running while someone is typing or locked out
+template <class Config> void BasicDwelling<Config>::unlock(void) {
+  PROFILE_SCOPE(ProfileUnlock);
+  unsigned long inState = millis() - _accessStateStarted;
+  if (_accessState != AccessEntering && _accessState != AccessUnlocked) {
+    // keys pressed while messages are up are dropped, as they were during the old delay()s
+    while (_keypad.getKey() != NO_KEY) {
+    }
+  }
+
+  switch (_accessState) {
+  case AccessPrompt:
+    if (_unlockFailures >= failureLimit) {
+      // locked out when the power failed: the delay starts over
+      lockOut();
+      _statusFrame.update();
+      break;
     }
-    bool goodCode = true;
-    for (int codeIndex = 0; codeIndex < codeLength; codeIndex++) {
-      if (input[codeIndex] != code[codeIndex]) {
-        goodCode = false;
-        break;
+    printToStatusDisplay(0, 0, F("Input PIN:     "));
+    _statusFrame.update();
+    _codeCharsEntered = 0;
+    _codeMatches = true;
+    enterAccessState(AccessEntering);
+    break;
+
+  case AccessEntering:
+    // every key latched since the last tick, however briefly it was pressed
+    for (char key = _keypad.getKey(); key != NO_KEY; key = _keypad.getKey()) {
+      enterCodeKey(key);
+      if (_accessState != AccessEntering) {
+        break; // the rest wait out the message, and are dropped
       }
     }
-    if (goodCode) {
-      _unlocked = true;
-      _accessStatus.turnOff();
-      _accessStatus.turnOnGreen();
-      Serial.println("Unlocked");
-      _statusDisplay.clear();
-      printToStatusDisplay(0, 0, "System Unlocked");
-      delay(2000);
-      _statusDisplay.clear();
+    break;
+
+  case AccessGranted:
+    if (inState >= grantedMillis) {
+      _statusFrame.clear();
+      _statusFrame.update();
+      enterAccessState(AccessUnlocked);
     }
-    else {
-      failures++;
-      if (failures == failureLimit) {
-        _statusDisplay.clear();
-        printToStatusDisplay(0, 0, "There Will Be A");
-        printToStatusDisplay(0, 1, "15 Second Delay");
-        delay(15000);
-        _statusDisplay.clear();
-        failures = 0;
-      }
-      else {
-        _statusDisplay.clear();
-        printToStatusDisplay(0, 0, 10, "Bad Code:", failures);
-        printToStatusDisplay(0, 1, "Try Again");
-        delay(5000);
+    break;
+
+  case AccessBadCode:
+  case AccessLockedOut:
+    if (inState >= (_accessState == AccessBadCode ? badCodeMillis : lockoutMillis)) {
+      if (_accessState == AccessLockedOut) {
+        _unlockFailures = 0; // served
+        journalState(true);
       }
+      _statusFrame.clear();
+      enterAccessState(AccessPrompt);
+    }
+    break;
+
+  case AccessUnlocked:
+    break;
+  }
+}
+
+// one key of the PIN; the last one decides
+template <class Config> void BasicDwelling<Config>::enterCodeKey(char key) {
+  _codeMatches = _codeMatches && (key == (char)pgm_read_byte(&code[_codeCharsEntered]));
+  printToStatusDisplay(10 + _codeCharsEntered, 0, F("*"));
+  _statusFrame.update();
+  _codeCharsEntered++;
+  if (_codeCharsEntered < codeLength) {
+    return;
+  }
 
-      _statusDisplay.clear();
+  _statusFrame.clear();
+  if (_codeMatches) {
+    _unlocked = true;
+    _unlockFailures = 0;
+    journalState(true);
+    _accessStatus.turnOff();
+    _accessStatus.turnOnGreen();
+    Telemetry::event(TelemetryUnlocked, 0);
+    printToStatusDisplay(0, 0, F("System Unlocked"));
+    enterAccessState(AccessGranted);
+  }
+  else {
+    _unlockFailures++;
+    journalState(true);
+    Telemetry::event(_unlockFailures == failureLimit ? TelemetryLockedOut : TelemetryBadCode, _unlockFailures);
+    if (_unlockFailures == failureLimit) {
+      lockOut();
+    }
+    else {
+      printToStatusDisplay(0, 0, 10, F("Bad Code:"), _unlockFailures);
+      printToStatusDisplay(0, 1, F("Try Again"));
+      enterAccessState(AccessBadCode);
     }
   }
+  _statusFrame.update();
 }
 
-void Dwelling::initStatusDisplay(void) {
-  _statusDisplay.init();
-  _statusDisplay.clear();
-  _statusDisplay.backlight();
+template <class Config> bool BasicDwelling<Config>::isUnlocked(void) {
+  return _unlocked;
+}
+
+template <class Config> void BasicDwelling<Config>::enterAccessState(AccessState state) {
+  _accessState = state;
+  _accessStateStarted = millis();
+}
+
+template <class Config> void BasicDwelling<Config>::lockOut(void) {
+  printToStatusDisplay(0, 0, F("There Will Be A"));
+  printToStatusDisplay(0, 1, F("15 Second Delay"));
+  enterAccessState(AccessLockedOut);
 }
 
-void Dwelling::lighting() {
+// The panel's power-on delays add up to over a second, so it is brought up a step at a time by
+//   statusDisplayStartup() while the rest of the dwelling runs from the first tick
+template <class Config> void BasicDwelling<Config>::initStatusDisplay(void) {
+  _statusDisplay.initAsync();
+  _statusFrame.clear();
+}
+
+template <class Config> void BasicDwelling<Config>::lighting(TickCount /*tickCount*/) {
+  PROFILE_SCOPE(ProfileLighting);
   // Turn _interiorLights on and off using button
-  static bool interiorLightsButtonWasPressed = false;
-  static bool exteriorLightsButtonWasPressed = false;
-  if (_interiorLightsButton.isOn()) {
-    if (!interiorLightsButtonWasPressed) {
-      // button has gone from unpressed to pressed
-      if (_interiorLights.isOn()) {
-        _interiorLights.turnOff();
-      }
-      else {
-        _interiorLights.turnOn();
-      }
+  if (_interiorLightsButton.wasTurnedOn()) {
+    if (_interiorLights.isOn()) {
+      _interiorLights.turnOff();
     }
-    interiorLightsButtonWasPressed = true;
-  }
-  else {
-    interiorLightsButtonWasPressed = false;
-  }
-  if (_exteriorLightsButton.isOn()) {
-    if (!exteriorLightsButtonWasPressed) {
-      // button has gone from unpressed to pressed
-      if (_exteriorLights.isOn()) {
-        _exteriorLights.turnOff();
-      }
-      else {
-        _exteriorLights.turnOn();
-        _exteriorLightsTurnedOnManually = true;
-      }
+    else {
+      _interiorLights.turnOn();
     }
-    exteriorLightsButtonWasPressed = true;
   }
-  else {
-    exteriorLightsButtonWasPressed = false;
+  if (_exteriorLightsButton.wasTurnedOn()) {
+    if (_exteriorLights.isOn()) {
+      _exteriorLights.turnOff();
+    }
+    else {
+      _exteriorLights.turnOn();
+      _exteriorLightsTurnedOnManually = true;
+    }
   }
 
   // manage interior light brightness based upon available power
@@ -191,7 +352,7 @@ void Dwelling::lighting() {
     if (_electricalStorage.powerLevel() == PowerCritical) {
       _alarmSystem.alarm(power_critical);
       if (_interiorLights.isOn()) {
-        _interiorLights.dimmerLevel(interiorLightsCritical); //
+        _interiorLights.dimmerLevel(Config::interiorLightsCritical); //
         _interiorLights.turnOn();
       }
       if (_exteriorLights.isOn()) {
@@ -201,30 +362,31 @@ void Dwelling::lighting() {
     else if (_electricalStorage.powerLevel() == PowerLow) {
       _alarmSystem.alarm(power_low);
       if (_interiorLights.isOn()) {
-        _interiorLights.dimmerLevel(interiorLightsLow);
+        _interiorLights.dimmerLevel(Config::interiorLightsLow);
         _interiorLights.turnOn();
       }
     }
   }
   else {
     if (_interiorLights.isOn()) {
-      _interiorLights.dimmerLevel(interiorLightsNormal);
+      _interiorLights.dimmerLevel(Config::interiorLightsNormal);
       _interiorLights.turnOn();
     }
   }
 }
 
-void Dwelling::batteryChargingAndUsage() {
-  static double solarPower = _solarArray.value();
+template <class Config> void BasicDwelling<Config>::batteryChargingAndUsage(TickCount /*tickCount*/) {
+  PROFILE_SCOPE(ProfileCharging);
+  static FixedPercent solarPower = _solarArray.value();
 
   _electricalStorage.chargeBattery(solarPower);
 
   // account for interiorLights power usage
   if (_interiorLights.isOn()) {
-    _electricalStorage.usePower(interiorLightsPowerUsage);
+    _electricalStorage.usePower(Config::interiorLightsPowerUsage);
   }
   if (_exteriorLights.isOn()) {
-    _electricalStorage.usePower(exteriorLightsPowerUsage);
+    _electricalStorage.usePower(Config::exteriorLightsPowerUsage);
   }
 }
 
@@ -240,10 +402,15 @@ A = intruder alarm active
 L = interior light switch pressed
 F = floodlight switch pressed
 */
-void Dwelling::statusDisplays(int tickCount) {
-  printToStatusDisplay(0, 0, 2, "T     ", tickCount / 10);
-  printToStatusDisplay(0, 1, 2, "B    ", int(_electricalStorage.batteryLevel()));
-  printToStatusDisplay(6, 1, 2, "S    ", int(_solarArray.value()));
+template <class Config> void BasicDwelling<Config>::statusDisplays(TickCount tickCount) {
+  PROFILE_SCOPE(ProfileStatusDisplays);
+  if (_accessState != AccessUnlocked) {
+    return; // the display belongs to PIN entry until the dwelling is unlocked and the message has gone
+  }
+
+  printToStatusDisplay(0, 0, 2, F("T     "), tickCount / 10);
+  printToStatusDisplay(0, 1, 2, F("B    "), wholePercent(_electricalStorage.batteryLevel()));
+  printToStatusDisplay(6, 1, 2, F("S    "), wholePercent(_solarArray.value()));
 
   printIndicatorToStatusDisplay(7, 0, _interiorLights.isOn(), 'i');
   printIndicatorToStatusDisplay(8, 0, _exteriorLights.isOn(), 'e');
@@ -251,35 +418,54 @@ void Dwelling::statusDisplays(int tickCount) {
 
   printIndicatorToStatusDisplay(11, 0, _interiorLightsButton.isOn(), 'L');
   printIndicatorToStatusDisplay(12, 0, _exteriorLightsButton.isOn(), 'E');
+
+  _statusFrame.update();
+}
+
+template <class Config> void BasicDwelling<Config>::printToStatusDisplay(uint8_t x, uint8_t y, const char *string) {
+  _statusFrame.setCursor(x, y);
+  _statusFrame.print(string);
 }
 
-void Dwelling::printToStatusDisplay(uint8_t x, uint8_t y, const char *string) {
-  _statusDisplay.setCursor(x, y);
-  _statusDisplay.print(string);
+template <class Config>
+void BasicDwelling<Config>::printToStatusDisplay(uint8_t x, uint8_t y, const __FlashStringHelper *string) {
+  _statusFrame.setCursor(x, y);
+  _statusFrame.print(string);
 }
 
-void Dwelling::printToStatusDisplay(uint8_t x, uint8_t y, int value) {
-  _statusDisplay.setCursor(x, y);
-  _statusDisplay.print(value);
+template <class Config> void BasicDwelling<Config>::printToStatusDisplay(uint8_t x, uint8_t y, int value) {
+  _statusFrame.setCursor(x, y);
+  _statusFrame.print(value);
+}
+
+template <class Config>
+void BasicDwelling<Config>::printToStatusDisplay(uint8_t x, uint8_t y, uint8_t valueOffset, const char *clearString,
+                                                 int value) {
+  printToStatusDisplay(x, y, clearString);
+  printToStatusDisplay(x + valueOffset, y, value);
 }
 
-void Dwelling::printToStatusDisplay(uint8_t x, uint8_t y, uint8_t valueOffset, const char *clearString, int value) {
+template <class Config>
+void BasicDwelling<Config>::printToStatusDisplay(uint8_t x, uint8_t y, uint8_t valueOffset,
+                                                 const __FlashStringHelper *clearString, int value) {
   printToStatusDisplay(x, y, clearString);
   printToStatusDisplay(x + valueOffset, y, value);
 }
 
-bool Dwelling::printIndicatorToStatusDisplay(uint8_t x, uint8_t y, bool print, const char indicator) {
-  _statusDisplay.setCursor(x, y);
+template <class Config>
+bool BasicDwelling<Config>::printIndicatorToStatusDisplay(uint8_t x, uint8_t y, bool print, const char indicator) {
+  _statusFrame.setCursor(x, y);
   if (print) {
-    _statusDisplay.print(indicator);
+    _statusFrame.print(indicator);
   }
   else {
-    _statusDisplay.print(" ");
+    _statusFrame.print(' ');
   }
   return print;
 }
 
-void Dwelling::houseBatteryStatusLight(int tickCount) {
+template <class Config> void BasicDwelling<Config>::houseBatteryStatusLight(TickCount tickCount) {
+  PROFILE_SCOPE(ProfileBatteryLight);
   switch (_electricalStorage.powerLevel()) {
   case PowerNearFull:
   case PowerFull:
@@ -297,9 +483,7 @@ void Dwelling::houseBatteryStatusLight(int tickCount) {
   // blink red if low but not critical
   // blink green if NearFull but not Full
   if (_electricalStorage.powerLevel() == PowerLow || _electricalStorage.powerLevel() == PowerNearFull) {
-    const int blinkSpeedTicks = 5;
-
-    if ((tickCount % blinkSpeedTicks) == 0) {
+    if ((tickCount % Config::batteryBlinkTicks) == 0) {
       if (_batteryStatusLight.isOn()) {
         _batteryStatusLight.turnOff();
       }
@@ -315,22 +499,28 @@ void Dwelling::houseBatteryStatusLight(int tickCount) {
   }
 }
 
-void Dwelling::exteriorMotionDetector(int ticks) {
-  if (_intruderAlarm.isOn()) {
+template <class Config> void BasicDwelling<Config>::exteriorMotionDetector(TickCount /*ticks*/) {
+  PROFILE_SCOPE(ProfileMotion);
+  // motion that started and stopped since the last tick still counts, for this tick
+  bool motion = _intruderAlarm.wasTurnedOn() || _intruderAlarm.isOn();
+  if (motion) {
     // turn exterior floodlights and alarm indicator on
     if (_electricalStorage.powerLevel() != PowerCritical) {
       _exteriorLights.turnOn();
       _exteriorLightsTurnedOnManually = false;
     }
-    if (_intruderAlarm.isOn()) {
-      _exteriorAlertLight.turnOn();
-    }
+    _exteriorAlertLight.turnOn();
   }
-  if (_intruderAlarm.isOff()) {
+  else {
     _exteriorAlertLight.turnOff();
     if (!_exteriorLightsTurnedOnManually) {
       _exteriorLights.turnOff();
       _exteriorLightsTurnedOnManually = false;
     }
   }
-}
\ No newline at end of file
+}
+
+template class BasicDwelling<MegaPanel>;
+#ifndef __AVR__
+template class BasicDwelling<TunablePanel>;
+#endif
@@ -11,6 +11,10 @@
 #include <Arduino.h>
 
 #include "dwelling.h"
+#include "idle_sleep.h"
+#include "profiler.h"
+#include "state_journal.h"
+#include "telemetry.h"
 
 // Timing constants
 const unsigned long oneTenthOfASecond = 100L; // one 'tick'
@@ -25,19 +29,23 @@ void setup() {
   while (!Serial)
     ;
 
-  dwelling.unlock();
-  Serial.println("setup complete");
+  Telemetry::event(TelemetrySetupComplete, 0);
 }
 
 // Arduino Loop
 // Instead of using delay(), millis() is used to enforce a timing 'tick' of
-// 1/10 of a second (oneTenthOfASecond).
+// 1/10 of a second (oneTenthOfASecond).  Between ticks the CPU sleeps, waking
+// for every interrupt (at least once a millisecond) to check the time, to
+// pass queued telemetry to Serial and to write journalled state to EEPROM.
 void loop() {
-  static int tickCount = 0;
+  static TickCount tickCount = 0;
   static unsigned long previousMillis = 0L;
   unsigned long currentMillis = millis();
 
+  Telemetry::pump();
+  StateJournal::service();
   if ((currentMillis - previousMillis) < oneTenthOfASecond) {
+    IdleSleep::sleep();
     return;
   }
 
@@ -45,4 +53,7 @@ void loop() {
   tickCount++;
 
   dwelling.tick(tickCount);
+
+  PROFILE_TICK(dwelling._scheduler.lastTickMicros(), oneTenthOfASecond * 1000);
+  PROFILE_REPORT(tickCount);
 }
\ No newline at end of file
@@ -0,0 +1,79 @@
+/*
+    bench.cpp
+    2026-10-17
+
+    Micro-benchmark harness for the host build
+    Design notes are in the .h file
+*/
+
+#include "bench.h"
+
+#include <fstream>
+#include <math.h>
+#include <sstream>
+#include <stdio.h>
+
+volatile unsigned long benchSink;
+
+void Bench::print(const BenchResult &result) const {
+  printf("%-28s %12.1f %12.2f %12.1f\n", result.name.c_str(), result.nsPerOp, result.i2cBytesPerOp,
+         result.boardMicrosPerOp);
+}
+
+bool Bench::write(const char *path, const std::string &label) const {
+  FILE *file = fopen(path, "w");
+  if (file == NULL) {
+    return false;
+  }
+  fprintf(file, "# %s\n", label.c_str());
+  fprintf(file, "case,ops,ns_per_op,i2c_bytes_per_op,board_us_per_op\n");
+  for (size_t i = 0; i < _results.size(); i++) {
+    const BenchResult &result = _results[i];
+    fprintf(file, "%s,%lu,%.2f,%.3f,%.2f\n", result.name.c_str(), result.ops, result.nsPerOp, result.i2cBytesPerOp,
+            result.boardMicrosPerOp);
+  }
+  return fclose(file) == 0;
+}
+
+bool Bench::compare(const char *path) const {
+  std::ifstream file(path);
+  if (!file) {
+    return false;
+  }
+  std::map<std::string, BenchResult> baseline;
+  std::string line, label;
+  while (std::getline(file, line)) {
+    if (line.empty() || line.compare(0, 5, "case,") == 0) {
+      continue;
+    }
+    if (line[0] == '#') {
+      label = line.substr(line.find_first_not_of("# "));
+      continue;
+    }
+    std::istringstream fields(line);
+    BenchResult result;
+    char comma;
+    std::getline(fields, result.name, ',');
+    fields >> result.ops >> comma >> result.nsPerOp >> comma >> result.i2cBytesPerOp >> comma >>
+        result.boardMicrosPerOp;
+    baseline[result.name] = result;
+  }
+
+  printf("\nagainst %s (%s)\n", path, label.c_str());
+  printf("%-28s %12s %12s %12s\n", "case", "ns/op", "was", "change");
+  for (size_t i = 0; i < _results.size(); i++) {
+    const BenchResult &result = _results[i];
+    std::map<std::string, BenchResult>::const_iterator was = baseline.find(result.name);
+    if (was == baseline.end()) {
+      printf("%-28s %12.1f %12s\n", result.name.c_str(), result.nsPerOp, "new");
+      continue;
+    }
+    double change = 100.0 * (result.nsPerOp - was->second.nsPerOp) / was->second.nsPerOp;
+    printf("%-28s %12.1f %12.1f %+11.1f%%", result.name.c_str(), result.nsPerOp, was->second.nsPerOp, change);
+    if (fabs(result.i2cBytesPerOp - was->second.i2cBytesPerOp) > 0.01 * was->second.i2cBytesPerOp + 0.001) {
+      printf("  i2c bytes/op %.2f, was %.2f", result.i2cBytesPerOp, was->second.i2cBytesPerOp);
+    }
+    printf("\n");
+  }
+  return true;
+}
@@ -0,0 +1,99 @@
+/*
+    bench.h
+    2026-10-17
+
+    Micro-benchmark harness for the host build
+
+    run(name, body) calls body(ops) with ops chosen so one repetition takes about
+        benchTargetMillis of host time, repeats it benchRepetitions times and keeps the fastest,
+        which is the least disturbed by the rest of the machine.  Each case records
+            ns/op           host time per operation
+            i2c bytes/op    bytes the code put on the simulated I2C bus
+            board us/op     simulated board time (modelled bus time, delays, and any time the
+                            body moves the clock itself) per operation
+    Bodies should feed their results to benchSink so the optimizer cannot drop the work.
+
+    Results are written as CSV, one row per case after a # comment line holding the label:
+        case,ops,ns_per_op,i2c_bytes_per_op,board_us_per_op
+    and a previous file can be read back to print the change of each case against it.
+*/
+
+#ifndef BENCH_H
+#define BENCH_H
+
+#include <chrono>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "sim_board.h"
+
+const double benchTargetMillis = 20;
+const int benchRepetitions = 5;
+
+extern volatile unsigned long benchSink;
+
+typedef struct {
+  std::string name;
+  unsigned long ops;
+  double nsPerOp;
+  double i2cBytesPerOp;
+  double boardMicrosPerOp;
+} BenchResult;
+
+class Bench {
+public:
+  Bench(SimBoard &board) :
+      _board(board) {
+  }
+
+  template <class Body> void run(const char *name, Body body) {
+    unsigned long ops = 1;
+    double seconds = time(body, ops);
+    while (seconds < benchTargetMillis / 1000) {
+      ops = seconds > 0 ? (unsigned long)(ops * benchTargetMillis / 1000 / seconds * 1.2) + 1 : ops * 16;
+      seconds = time(body, ops);
+    }
+
+    BenchResult result;
+    result.name = name;
+    result.ops = ops;
+    result.nsPerOp = seconds * 1e9 / ops;
+    for (int repetition = 0; repetition < benchRepetitions; repetition++) {
+      unsigned long bytes = _board.i2cStats().bytes;
+      unsigned long micros = _board.micros();
+      seconds = time(body, ops);
+      double nsPerOp = seconds * 1e9 / ops;
+      if (repetition == 0 || nsPerOp < result.nsPerOp) {
+        result.nsPerOp = nsPerOp;
+      }
+      result.i2cBytesPerOp = (double)(_board.i2cStats().bytes - bytes) / ops;
+      result.boardMicrosPerOp = (double)(_board.micros() - micros) / ops;
+    }
+    _results.push_back(result);
+    print(result);
+  }
+
+  const std::vector<BenchResult> &results(void) const {
+    return _results;
+  }
+
+  bool write(const char *path, const std::string &label) const;
+  // print each case's change against a file written earlier; false if it cannot be read
+  bool compare(const char *path) const;
+
+private:
+  template <class Body> double time(Body &body, unsigned long ops) {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    body(ops);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count();
+  }
+
+  void print(const BenchResult &result) const;
+
+  SimBoard &_board;
+  std::vector<BenchResult> _results;
+};
+
+#endif
@@ -0,0 +1,258 @@
+/*
+    bench_main.cpp
+    2026-10-17
+
+    Entry point for the benchmark build: every component's hot calls, then Dwelling::tick()
+
+    Standalone components (polled inputs, a plain Keypad, a HouseBattery) are measured first, on
+        pins the dwelling leaves free or before the dwelling claims the keypad; the dwelling's
+        own components are then measured as it configures them, after init() and the PIN.
+    The SpscRing case times a producer thread, standing in for the interrupt, against the main
+        loop's pops; test/test_spsc_ring checks the records arrive intact.
+    See bench.h for what each column means and for the results file.
+
+    usage: program [--out <results.csv>] [--label <text>] [--compare <earlier results.csv>]
+*/
+
+#include <Arduino.h>
+
+#include <Keypad.h>
+#include <stdio.h>
+#include <string.h>
+#include <thread>
+
+#include "DigitalPinIO.h"
+#include "bench.h"
+#include "dwelling.h"
+#include "dwelling_rig.h"
+#include "photoresistor.h"
+#include "pins.h"
+#include "power.h"
+#include "sim_board.h"
+#include "spsc_ring.h"
+#include "telemetry.h"
+
+const char defaultResultsPath[] = "bench_results.csv";
+const unsigned long oneTenthOfASecond = 100L; // one 'tick', as in main.cpp
+
+// pins nothing else on the panel uses
+const uint8_t spareInputPin = 30;
+const uint8_t spareOutputPin = 42;
+const uint8_t spareAnalogPin = 1;
+
+static char keypadLayout[] = "123A456B789C*0#D";
+static byte keypadRowPins[] = {keypad00, keypad01, keypad02, keypad03};
+static byte keypadColumnPins[] = {keypad04, keypad05, keypad06, keypad07};
+
+static void standaloneCases(Bench &bench, SimBoard &board) {
+  DigitalPinIn polledInput(spareInputPin, DigitalPinIO::withPullup, DigitalPinIO::lowOn);
+  bench.run("DigitalPinIn.isOn polled", [&](unsigned long ops) {
+    for (unsigned long i = 0; i < ops; i++) {
+      benchSink += polledInput.isOn();
+    }
+  });
+
+  DigitalPinOut output(spareOutputPin, DigitalPinIO::highOn);
+  bench.run("DigitalPinOut.toggle", [&](unsigned long ops) {
+    for (unsigned long i = 0; i < ops; i++) {
+      output.toggle();
+    }
+  });
+
+  HouseBattery battery;
+  bench.run("HouseBattery.chargeBattery", [&](unsigned long ops) {
+    for (unsigned long i = 0; i < ops; i++) {
+      battery.chargeBattery(fixedPercent(i & 0x3F));
+      battery.usePower(fixedPercent(1));
+    }
+  });
+  bench.run("HouseBattery.powerLevel", [&](unsigned long ops) {
+    for (unsigned long i = 0; i < ops; i++) {
+      benchSink += battery.powerLevel();
+    }
+  });
+
+  PhotoResistor polledPhotoResistor(spareAnalogPin);
+  board.setAnalogInput(spareAnalogPin, 600);
+  bench.run("PhotoResistor.value polled", [&](unsigned long ops) {
+    for (unsigned long i = 0; i < ops; i++) {
+      benchSink += polledPhotoResistor.value();
+    }
+  });
+
+  // a full matrix scan happens at most once per debounce period, so time moves 10ms per call
+  Keypad keypad(keypadLayout, keypadRowPins, keypadColumnPins, 4, 4);
+  bench.run("Keypad.getKey scan", [&](unsigned long ops) {
+    for (unsigned long i = 0; i < ops; i++) {
+      board.advanceMillis(10);
+      benchSink += keypad.getKey();
+    }
+  });
+}
+
+// ops records through a small ring between two threads
+static void spscRingCase(Bench &bench) {
+  typedef EventRecord<uint32_t> SequencedRecord;
+  bench.run("SpscRing threads push/pop", [&](unsigned long ops) {
+    SpscRing<SequencedRecord, 16> ring;
+    std::thread producer([&]() {
+      SequencedRecord record;
+      record.millis = 0;
+      record.source = 0;
+      for (unsigned long i = 0; i < ops; i++) {
+        record.payload = (uint32_t)i;
+        record.source = (uint8_t)(i * 7);
+        while (ring.full()) {
+          std::this_thread::yield(); // the consumer is behind
+        }
+        ring.push(record);
+      }
+    });
+    SequencedRecord record = SequencedRecord();
+    for (unsigned long popped = 0; popped < ops;) {
+      if (!ring.pop(record)) {
+        std::this_thread::yield();
+      }
+      else {
+        popped++;
+      }
+    }
+    producer.join();
+    benchSink += record.payload;
+  });
+}
+
+static void dwellingCases(Bench &bench, SimBoard &board, Dwelling &dwelling) {
+  bench.run("DigitalPinIn.isOn interrupt", [&](unsigned long ops) {
+    for (unsigned long i = 0; i < ops; i++) {
+      benchSink += dwelling._interiorLightsButton.isOn();
+    }
+  });
+
+  bench.run("FastPinOut.toggle", [&](unsigned long ops) {
+    for (unsigned long i = 0; i < ops; i++) {
+      dwelling._exteriorAlertLight.toggle();
+    }
+  });
+
+  bench.run("PhotoResistor.value sampled", [&](unsigned long ops) {
+    for (unsigned long i = 0; i < ops; i++) {
+      benchSink += dwelling._solarArray.value();
+    }
+  });
+
+  bench.run("InterruptKeypad.getKey idle", [&](unsigned long ops) {
+    for (unsigned long i = 0; i < ops; i++) {
+      board.advanceMillis(10);
+      benchSink += dwelling._keypad.getKey();
+    }
+  });
+
+  bench.run("LiquidCrystal_I2C.print 16", [&](unsigned long ops) {
+    for (unsigned long i = 0; i < ops; i++) {
+      dwelling._statusDisplay.setCursor(0, 1);
+      dwelling._statusDisplay.print(i & 1 ? "0123456789ABCDEF" : "FEDCBA9876543210");
+    }
+  });
+
+  bench.run("LCDFrameBuffer.update none", [&](unsigned long ops) {
+    for (unsigned long i = 0; i < ops; i++) {
+      benchSink += dwelling._statusFrame.update();
+    }
+  });
+
+  bench.run("LCDFrameBuffer.update 1", [&](unsigned long ops) {
+    for (unsigned long i = 0; i < ops; i++) {
+      dwelling._statusFrame.setCursor(15, 1);
+      dwelling._statusFrame.write(i & 1 ? '+' : '-');
+      benchSink += dwelling._statusFrame.update();
+    }
+  });
+
+  bench.run("LCDFrameBuffer.update all", [&](unsigned long ops) {
+    for (unsigned long i = 0; i < ops; i++) {
+      dwelling._statusFrame.invalidate();
+      benchSink += dwelling._statusFrame.update();
+    }
+  });
+
+  // a tick's frame: CRC, COBS, through the queue to Serial
+  bench.run("Telemetry.tick+pump", [&](unsigned long ops) {
+    TelemetryTickRecord record;
+    memset(&record, 0, sizeof(record));
+    for (unsigned long i = 0; i < ops; i++) {
+      record.tickCount = i;
+      record.battery = i * 7;
+      Telemetry::tick(record);
+      Telemetry::pump();
+      board.serialOutput().clear();
+    }
+  });
+
+  int tick = 0;
+  bench.run("Dwelling.statusDisplays", [&](unsigned long ops) {
+    for (unsigned long i = 0; i < ops; i++) {
+      board.setAnalogInput(solarArrayAnalogInputPin, 200 + (i % 800));
+      board.advanceMillis(oneTenthOfASecond);
+      dwelling.statusDisplays(++tick);
+    }
+  });
+
+  // as native_main: the light ramps, an intruder comes by, the interior light is tapped
+  bench.run("Dwelling.tick", [&](unsigned long ops) {
+    for (unsigned long i = 0; i < ops; i++) {
+      board.setAnalogInput(solarArrayAnalogInputPin, 200 + (tick % 6000) / 8);
+      board.setInput(intruderMotionAlarmPin, (tick % 450) < 50 ? HIGH : LOW);
+      board.setInput(interiorLightsButtonPin, (tick % 200) == 0 ? LOW : HIGH);
+      dwelling.tick(++tick);
+      Telemetry::pump(); // drained as the port would, so frames are encoded rather than dropped
+      board.serialOutput().clear();
+      board.advanceMillis(oneTenthOfASecond);
+    }
+  });
+}
+
+int main(int argc, char **argv) {
+  const char *resultsPath = defaultResultsPath;
+  const char *comparePath = NULL;
+  std::string label = "unlabelled";
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--out") == 0 && i + 1 < argc) {
+      resultsPath = argv[++i];
+    }
+    else if (strcmp(argv[i], "--label") == 0 && i + 1 < argc) {
+      label = argv[++i];
+    }
+    else if (strcmp(argv[i], "--compare") == 0 && i + 1 < argc) {
+      comparePath = argv[++i];
+    }
+    else {
+      fprintf(stderr, "usage: %s [--out <results.csv>] [--label <text>] [--compare <earlier results.csv>]\n",
+              argv[0]);
+      return 2;
+    }
+  }
+
+  SimBoard &board = SimBoard::active();
+  DwellingRig rig(board);
+  Bench bench(board);
+  printf("%-28s %12s %12s %12s\n", "case", "ns/op", "i2c bytes/op", "board us/op");
+
+  standaloneCases(bench, board);
+  spscRingCase(bench);
+
+  Dwelling dwelling;
+  dwelling.init();
+  rig.unlock(dwelling);
+  dwellingCases(bench, board, dwelling);
+
+  if (!bench.write(resultsPath, label)) {
+    fprintf(stderr, "cannot write %s\n", resultsPath);
+    return 1;
+  }
+  if (comparePath != NULL && !bench.compare(comparePath)) {
+    fprintf(stderr, "cannot read %s\n", comparePath);
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,56 @@
+/*
+    dwelling_rig.cpp
+    2026-10-17
+
+    The dwelling's outside world on the simulated board, for the host programs
+    Design notes are in the .h file
+*/
+
+#include "dwelling_rig.h"
+
+#include <Arduino.h>
+
+#include "pins.h"
+
+const char unlockCode[] = "7452A0";
+
+// the panel's keypad, as wired
+static const MegaPanel::KeypadLayout &keypadWiring = MegaPanel::keypad;
+
+DwellingRig::DwellingRig(SimBoard &board) :
+    board(board), lcd(16, 2),
+    keypad(keypadWiring.keys, keypadWiring.rowPins, keypadWiring.columnPins, keypadWiring.rowCount,
+           keypadWiring.columnCount) {
+  board.attachI2C(MegaPanel::statusDisplayAddress, &lcd);
+  board.attachInputSource(&keypad);
+  board.setInput(interiorLightsButtonPin, HIGH);
+  board.setInput(exteriorLightsButtonPin, HIGH);
+  board.setInput(intruderMotionAlarmPin, LOW);
+  board.setAnalogInput(solarArrayAnalogInputPin, 0);
+}
+
+int DwellingRig::unlock(Dwelling &dwelling) {
+  const unsigned long tapMillis = 60;
+  const unsigned long keyMillis = 150;
+  const unsigned long stepMillis = 10;
+  int tick = 0;
+  unsigned long typing = (sizeof(unlockCode) - 1) * keyMillis;
+  for (unsigned long t = 0; t < typing; t += stepMillis) {
+    char key = unlockCode[t / keyMillis];
+    if (t % keyMillis == 0) {
+      keypad.press(key);
+    }
+    if (t % keyMillis == tapMillis) {
+      keypad.release(key);
+    }
+    board.advanceMillis(stepMillis);
+    if ((t + stepMillis) % 100 == 0) {
+      dwelling.tick(++tick);
+    }
+  }
+  while (!dwelling.isUnlocked() || tick < 100) {
+    dwelling.tick(++tick);
+    board.advanceMillis(100);
+  }
+  return tick;
+}
@@ -0,0 +1,39 @@
+/*
+    dwelling_rig.h
+    2026-10-17
+
+    The dwelling's outside world on the simulated board, for the host programs
+
+    Wires what the panel has besides the Mega, as MegaPanel has it (see dwelling_config.h): the
+        LCD and the 4x4 keypad matrix, and leaves every input at rest (buttons released, no
+        motion, the solar array dark).
+        Construct it before the Dwelling, on the board that will be active when the Dwelling is
+        built.
+    unlock() types the PIN at a human pace, a 60ms tap every 150ms, so most presses start and
+        end between two 100ms ticks, and ticks on until the status display has taken over from
+        the access messages.
+*/
+
+#ifndef DWELLING_RIG_H
+#define DWELLING_RIG_H
+
+#include "dwelling.h"
+#include "sim_board.h"
+#include "sim_keypad.h"
+#include "sim_lcd.h"
+
+extern const char unlockCode[];
+
+class DwellingRig {
+public:
+  DwellingRig(SimBoard &board);
+
+  // returns the number of ticks it took
+  int unlock(Dwelling &dwelling);
+
+  SimBoard &board;
+  SimLCD lcd;
+  SimKeypadMatrix keypad;
+};
+
+#endif
@@ -0,0 +1,149 @@
+/*
+    dwelling_sim.cpp
+    2026-10-17
+
+    Entry point for the dwelling simulator (host build)
+
+    Runs the unmodified Dwelling through a scenario (see scenario.h) on SimHardware's simulated
+        Mega, one 100 ms tick after another, with the simulated clock jumping from each tick or
+        scripted event straight to the next: a month of operation takes seconds.
+
+    The trace goes to stdout as CSV, one row per sample period and one per transition:
+        seconds,event,battery,solar,power,interior,exterior,alert
+            event       sample, power (the battery's power level changed) or lights (an
+                        interior, floodlight or alert light output changed)
+            battery     percent
+            solar       percent, as the dwelling reads it
+            power       Critical, Low, Middle, NearFull or Full
+            interior    PWM duty of the interior lights (0 off)
+            exterior    floodlights, 0 or 1
+            alert       exterior alert light, 0 or 1
+    A summary (time in each power level, transitions, host time) goes to stderr.
+    Given a capture file, the telemetry the dwelling sends over Serial is written to it, as a
+        board's would be captured from its port, for the telemetry decoder (see telemetry.h).
+
+    usage: program <scenario file> [telemetry capture file]
+*/
+
+#include <Arduino.h>
+
+#include <chrono>
+#include <stdio.h>
+
+#include "dwelling.h"
+#include "dwelling_rig.h"
+#include "pins.h"
+#include "scenario.h"
+#include "sim_board.h"
+#include "telemetry.h"
+
+const unsigned long oneTenthOfASecond = 100L; // one 'tick', as in main.cpp
+
+static const char *const powerLevelNames[] = {"Critical", "Low", "Middle", "NearFull", "Full"};
+
+typedef struct {
+  HouseBatteryPowerLevel power;
+  int interior;
+  int exterior;
+  int alert;
+} DwellingState;
+
+static DwellingState observe(Dwelling &dwelling, SimBoard &board) {
+  DwellingState state;
+  state.power = dwelling._electricalStorage.powerLevel();
+  state.interior = board.pwmDuty(interiorLightsPWMControlPin);
+  state.exterior = board.outputLevel(exteriorFloodlightsPin);
+  state.alert = board.outputLevel(exteriorAlertLightPin);
+  return state;
+}
+
+static void trace(const char *event, Dwelling &dwelling, SimBoard &board, const DwellingState &state) {
+  printf("%.1f,%s,%.2f,%u,%s,%d,%d,%d\n", board.millis() / 1000.0, event,
+         (double)dwelling._electricalStorage.batteryLevel() / fixedPercentScale,
+         wholePercent(dwelling._solarArray.value()), powerLevelNames[state.power], state.interior, state.exterior,
+         state.alert);
+}
+
+int main(int argc, char **argv) {
+  if (argc != 2 && argc != 3) {
+    fprintf(stderr, "usage: %s <scenario file> [telemetry capture file]\n", argv[0]);
+    return 2;
+  }
+  Scenario scenario;
+  std::string error;
+  if (!scenario.load(argv[1], error)) {
+    fprintf(stderr, "%s: %s\n", argv[1], error.c_str());
+    return 1;
+  }
+
+  FILE *capture = NULL;
+  if (argc == 3 && (capture = fopen(argv[2], "wb")) == NULL) {
+    fprintf(stderr, "cannot write %s\n", argv[2]);
+    return 1;
+  }
+
+  SimBoard &board = SimBoard::active();
+  DwellingRig rig(board);
+  Dwelling dwelling;
+  dwelling.init();
+
+  printf("seconds,event,battery,solar,power,interior,exterior,alert\n");
+  DwellingState last = observe(dwelling, board);
+  trace("sample", dwelling, board, last);
+
+  unsigned long long levelMillis[PowerFull + 1] = {0};
+  unsigned long powerTransitions = 0;
+  unsigned long lightTransitions = 0;
+  unsigned long long nextTrace = scenario.traceMillis;
+  unsigned long long nextTick = board.millis();
+  int tick = 0;
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  while (nextTick < scenario.runMillis) {
+    scenario.runUntil(rig, nextTick);
+    if (board.millis() < nextTick) {
+      board.advanceMicros((nextTick - board.millis()) * 1000);
+    }
+    dwelling.tick(++tick);
+    if (capture != NULL) {
+      Telemetry::pump();
+      fwrite(board.serialOutput().data(), 1, board.serialOutput().size(), capture);
+      board.serialOutput().clear();
+    }
+
+    DwellingState state = observe(dwelling, board);
+    levelMillis[state.power] += oneTenthOfASecond;
+    if (state.power != last.power) {
+      powerTransitions++;
+      trace("power", dwelling, board, state);
+    }
+    else if (state.interior != last.interior || state.exterior != last.exterior || state.alert != last.alert) {
+      lightTransitions++;
+      trace("lights", dwelling, board, state);
+    }
+    else if (scenario.traceMillis != 0 && nextTick >= nextTrace) {
+      trace("sample", dwelling, board, state);
+    }
+    if (scenario.traceMillis != 0 && nextTick >= nextTrace) {
+      nextTrace += scenario.traceMillis;
+    }
+    last = state;
+    nextTick += oneTenthOfASecond;
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  if (capture != NULL && fclose(capture) != 0) {
+    fprintf(stderr, "cannot write %s\n", argv[2]);
+    return 1;
+  }
+
+  double days = board.millis() / (double)scenarioMillisPerDay;
+  fprintf(stderr, "simulated           %.2f days, %d ticks\n", days, tick);
+  fprintf(stderr, "host seconds        %.2f (%.0fx real time)\n", elapsed.count(),
+          board.millis() / 1000.0 / elapsed.count());
+  fprintf(stderr, "power transitions   %lu\n", powerTransitions);
+  fprintf(stderr, "light transitions   %lu\n", lightTransitions);
+  for (int level = PowerCritical; level <= PowerFull; level++) {
+    fprintf(stderr, "%-19s %.1f%%\n", powerLevelNames[level], tick ? 100.0 * levelMillis[level] / (tick * 100.0) : 0.0);
+  }
+  return 0;
+}
@@ -0,0 +1,103 @@
+/*
+    native_main.cpp
+    2026-10-17
+
+    Entry point for the native (host) build
+
+    Runs the unmodified Dwelling against SimHardware's simulated Mega as fast as the host allows,
+        stepping the virtual clock one 100 ms tick at a time, and reports:
+            host time per tick (the hot path's cost, for benchmarking)
+            simulated I2C traffic and the board time the blocking bus would have used per tick
+            the telemetry sent over Serial per tick
+            the final panel contents and battery level (a digest for regression runs)
+            the scheduler's per task statistics in board time
+
+    usage: program [ticks]
+    Not built under pio test, whose tests (test/) bring their own main().
+*/
+
+#ifndef PIO_UNIT_TESTING
+
+#include <Arduino.h>
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "dwelling.h"
+#include "dwelling_rig.h"
+#include "pins.h"
+#include "sim_board.h"
+#include "telemetry.h"
+
+const unsigned long defaultTicks = 1000000L;
+const unsigned long oneTenthOfASecond = 100L; // one 'tick', as in main.cpp
+
+// Deterministic inputs so two runs of the same tree produce the same digest
+static void stimulate(SimBoard &board, unsigned long tick) {
+  // solar array follows a slow ramp up and down over a simulated ten minutes
+  unsigned long phase = tick % 6000;
+  int light = phase < 3000 ? phase / 3 : (6000 - phase) / 3;
+  board.setAnalogInput(solarArrayAnalogInputPin, 200 + light * 8 / 10);
+
+  // an intruder walks past every 45 seconds and lingers for 5
+  board.setInput(intruderMotionAlarmPin, (tick % 450) < 50 ? HIGH : LOW);
+
+  // the interior light switch is tapped every 20 seconds
+  board.setInput(interiorLightsButtonPin, (tick % 200) == 0 ? LOW : HIGH);
+}
+
+int main(int argc, char **argv) {
+  unsigned long ticks = argc > 1 ? strtoul(argv[1], NULL, 10) : defaultTicks;
+
+  SimBoard &board = SimBoard::active();
+  DwellingRig rig(board);
+
+  Dwelling dwelling;
+  dwelling.init();
+  int firstTick = rig.unlock(dwelling) + 1;
+  board.resetI2CStats();
+  dwelling._scheduler.resetStatistics();
+
+  board.serialOutput().clear();
+  unsigned long boardMicros = 0;
+  unsigned long long serialBytes = 0;
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  for (unsigned long tick = firstTick; tick < firstTick + ticks; tick++) {
+    stimulate(board, tick);
+    unsigned long before = board.micros();
+    dwelling.tick(tick);
+    boardMicros += board.micros() - before;
+    Telemetry::pump(); // as loop() does
+    serialBytes += board.serialOutput().size();
+    board.serialOutput().clear();
+    board.advanceMillis(oneTenthOfASecond);
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  const SimI2CStats &i2c = board.i2cStats();
+  double seconds = elapsed.count();
+  printf("ticks               %lu\n", ticks);
+  printf("host seconds        %.3f\n", seconds);
+  printf("ticks/second        %.0f\n", ticks / seconds);
+  printf("ns/tick             %.1f\n", seconds * 1e9 / ticks);
+  printf("i2c bytes/tick      %.1f\n", (double)i2c.bytes / ticks);
+  printf("i2c transfers/tick  %.1f\n", (double)i2c.transactions / ticks);
+  printf("board us/tick       %.1f\n", (double)boardMicros / ticks);
+  printf("serial bytes/tick   %.1f\n", (double)serialBytes / ticks);
+  printf("battery             %.2f\n", (double)dwelling._electricalStorage.batteryLevel() / fixedPercentScale);
+  printf("lcd                 [%s]\n", rig.lcd.text(0).c_str());
+  printf("                    [%s]\n", rig.lcd.text(1).c_str());
+
+  // per task board time, from the scheduler's own statistics (virtual micros)
+  printf("\n%-14s %10s %10s %10s %8s\n", "task", "runs", "avg us", "worst us", "missed");
+  for (uint8_t i = 0; i < dwelling._scheduler.taskCount(); i++) {
+    const TaskStatistics &statistics = dwelling._scheduler.statistics(i);
+    printf("%-14s %10lu %10.1f %10lu %8lu\n", dwelling._scheduler.task(i).name, statistics.runs,
+           statistics.runs ? (double)statistics.totalMicros / statistics.runs : 0.0, statistics.worstMicros,
+           statistics.missedDeadlines);
+  }
+  return 0;
+}
+
+#endif
@@ -0,0 +1,327 @@
+/*
+    neighbourhood.cpp
+    2026-10-17
+
+    Entry point for the neighbourhood simulator (host build)
+
+    Runs a site of independent dwellings sharing a microgrid.  Every unit is the unmodified
+        Dwelling on its own simulated board (see sim_board.h, board_local.h), driven by its own
+        copy of the site's scenario (see scenario.h):
+            the site's sun, with clouds of the unit's own when the scenario has clouds
+            the site's keys and button presses
+            intruders of the unit's own, --intruders a day at random times, 10s to 2m each
+    The units run a simulated second at a time on a work stealing pool (see work_pool.h); between
+        seconds the power exchange moves charge from the fuller batteries to the emptier ones:
+            each unit offers, or asks for, --rate of its distance from the site's mean level,
+                at most --link percent of a battery a second
+            what flows is the smaller of the total offered and the total asked for, shared out
+                in proportion, and --loss percent of it is lost on the way
+        The exchange is a pass over the batteries, a few ns a unit against the microseconds of
+        each unit's ten ticks.  It and the trace run on the calling thread alone; the summary
+        gives their share s of the host time, which bounds the speedup on n cores to
+        1 / (s + (1 - s) / n).  Results do not depend on the number of threads: every unit's
+        second is its own, and the exchange runs alone.
+
+    The trace goes to stdout as CSV, one row per scenario trace period:
+        seconds,mean,min,max,critical,low,middle,near_full,full,sent,received
+            mean .. max     battery, percent
+            critical .. full    units at each power level
+            sent, received  through the exchange since the last row, in percent of a battery
+    A summary (host time, speed, steals, serial share, time at each power level) goes to stderr.
+
+    usage: program [--units <n>] [--threads <n, 0 for one per core>] [--grain <units per chunk>]
+                   [--intruders <per unit per day>] [--rate <0-1>] [--link <percent>]
+                   [--loss <percent>] [--seed <n>] <scenario file>
+*/
+
+#include <Arduino.h>
+
+#include <chrono>
+#include <math.h>
+#include <memory>
+#include <random>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "dwelling.h"
+#include "dwelling_rig.h"
+#include "fixed_percent.h"
+#include "scenario.h"
+#include "sim_board.h"
+#include "work_pool.h"
+
+const unsigned long oneTenthOfASecond = 100L; // one 'tick', as in main.cpp
+const unsigned long oneSecond = 1000L;        // between exchanges
+
+typedef struct {
+  double rate;       // share of the distance from the mean offered or asked for in a second
+  FixedPercent link; // most one unit sends or takes in a second
+  double loss;       // share of what is sent that never arrives
+} ExchangeModel;
+
+typedef struct {
+  double sent; // FixedPercent units
+  double received;
+} ExchangeTotals;
+
+class Unit {
+public:
+  Unit(const Scenario &site, unsigned long seed, double intrudersPerDay) :
+      scenario(site), nextTick(0), tick(0) {
+    memset(levelTicks, 0, sizeof(levelTicks));
+    scenario.reseedClouds(seed);
+    addIntruders(seed, intrudersPerDay);
+
+    SimBoard::Scope scope(board);
+    rig.reset(new DwellingRig(board));
+    dwelling.reset(new Dwelling());
+    dwelling->init();
+    nextTick = board.millis();
+  }
+
+  // tick up to millis, on whatever thread
+  void runUntil(unsigned long long millis) {
+    SimBoard::Scope scope(board);
+    while (nextTick < millis) {
+      scenario.runUntil(*rig, nextTick);
+      if (board.millis() < nextTick) {
+        board.advanceMicros((nextTick - board.millis()) * 1000);
+      }
+      dwelling->tick(++tick);
+      levelTicks[dwelling->_electricalStorage.powerLevel()]++;
+      nextTick += oneTenthOfASecond;
+    }
+  }
+
+  SimBoard board;
+  std::unique_ptr<DwellingRig> rig;
+  std::unique_ptr<Dwelling> dwelling;
+  Scenario scenario;
+  unsigned long long nextTick;
+  int tick;
+  unsigned long long levelTicks[PowerFull + 1];
+
+private:
+  void addIntruders(unsigned long seed, double perDay) {
+    if (perDay <= 0) {
+      return;
+    }
+    std::mt19937 random(seed);
+    std::exponential_distribution<double> gap(perDay / scenarioMillisPerDay);
+    std::uniform_int_distribution<int> seconds(10, 120);
+    std::string script;
+    for (double when = gap(random); when < scenario.runMillis; when += gap(random)) {
+      unsigned long long at = (unsigned long long)when / 1000;
+      char line[64];
+      snprintf(line, sizeof(line), "motion %llu.%02llu:%02llu:%02llu %ds\n", at / 86400, at / 3600 % 24, at / 60 % 60,
+               at % 60, seconds(random));
+      script += line;
+    }
+    std::string error;
+    scenario.parse(script, error); // well formed by construction
+  }
+};
+
+// one second of the microgrid
+static void exchangePower(std::vector<std::unique_ptr<Unit>> &units, const ExchangeModel &model,
+                          std::vector<double> &offers, ExchangeTotals &totals) {
+  double mean = 0;
+  for (size_t i = 0; i < units.size(); i++) {
+    mean += units[i]->dwelling->_electricalStorage.batteryLevel();
+  }
+  mean /= units.size();
+
+  double offered = 0; // to send
+  double asked = 0;   // to take
+  for (size_t i = 0; i < units.size(); i++) {
+    double offer = (units[i]->dwelling->_electricalStorage.batteryLevel() - mean) * model.rate;
+    offer = offer > model.link ? model.link : offer < -(double)model.link ? -(double)model.link : offer;
+    offers[i] = offer;
+    if (offer > 0) {
+      offered += offer;
+    }
+    else {
+      asked -= offer;
+    }
+  }
+  double flow = offered < asked ? offered : asked;
+  if (flow < 1) {
+    return; // less than the battery's resolution
+  }
+
+  for (size_t i = 0; i < units.size(); i++) {
+    HouseBattery &battery = units[i]->dwelling->_electricalStorage;
+    if (offers[i] > 0) {
+      FixedPercent sent = (FixedPercent)(offers[i] * flow / offered + 0.5);
+      battery.usePower(sent);
+      totals.sent += sent;
+    }
+    else if (offers[i] < 0) {
+      FixedPercent received = (FixedPercent)(-offers[i] * flow / asked * (1 - model.loss) + 0.5);
+      battery.receivePower(received);
+      totals.received += received;
+    }
+  }
+}
+
+static void trace(double seconds, std::vector<std::unique_ptr<Unit>> &units, const ExchangeTotals &exchanged) {
+  unsigned long counts[PowerFull + 1] = {0};
+  double sum = 0;
+  FixedPercent lowest = fixedPercent(100);
+  FixedPercent highest = 0;
+  for (size_t i = 0; i < units.size(); i++) {
+    HouseBattery &battery = units[i]->dwelling->_electricalStorage;
+    FixedPercent level = battery.batteryLevel();
+    sum += level;
+    lowest = level < lowest ? level : lowest;
+    highest = level > highest ? level : highest;
+    counts[battery.powerLevel()]++;
+  }
+  printf("%.0f,%.2f,%.2f,%.2f,%lu,%lu,%lu,%lu,%lu,%.2f,%.2f\n", seconds, sum / units.size() / fixedPercentScale,
+         (double)lowest / fixedPercentScale, (double)highest / fixedPercentScale, counts[PowerCritical],
+         counts[PowerLow], counts[PowerMiddle], counts[PowerNearFull], counts[PowerFull],
+         exchanged.sent / fixedPercentScale, exchanged.received / fixedPercentScale);
+}
+
+static void usage(const char *program) {
+  fprintf(stderr,
+          "usage: %s [--units <n>] [--threads <n, 0 for one per core>] [--grain <units per chunk>]\n"
+          "          [--intruders <per unit per day>] [--rate <0-1>] [--link <percent>] [--loss <percent>]\n"
+          "          [--seed <n>] <scenario file>\n",
+          program);
+}
+
+int main(int argc, char **argv) {
+  size_t unitCount = 100;
+  unsigned threads = 0;
+  size_t grain = 0;
+  double intrudersPerDay = 1;
+  unsigned long seed = 1;
+  ExchangeModel model;
+  model.rate = 0.25;
+  model.link = fixedPercent(1);
+  model.loss = 0.05;
+  const char *scenarioPath = NULL;
+  for (int i = 1; i < argc; i++) {
+    bool value = i + 1 < argc;
+    if (strcmp(argv[i], "--units") == 0 && value) {
+      unitCount = strtoul(argv[++i], NULL, 10);
+    }
+    else if (strcmp(argv[i], "--threads") == 0 && value) {
+      threads = strtoul(argv[++i], NULL, 10);
+    }
+    else if (strcmp(argv[i], "--grain") == 0 && value) {
+      grain = strtoul(argv[++i], NULL, 10);
+    }
+    else if (strcmp(argv[i], "--intruders") == 0 && value) {
+      intrudersPerDay = atof(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--rate") == 0 && value) {
+      model.rate = atof(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--link") == 0 && value) {
+      model.link = (FixedPercent)(atof(argv[++i]) * fixedPercentScale + 0.5);
+    }
+    else if (strcmp(argv[i], "--loss") == 0 && value) {
+      model.loss = atof(argv[++i]) / 100;
+    }
+    else if (strcmp(argv[i], "--seed") == 0 && value) {
+      seed = strtoul(argv[++i], NULL, 10);
+    }
+    else if (argv[i][0] != '-' && scenarioPath == NULL) {
+      scenarioPath = argv[i];
+    }
+    else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if (scenarioPath == NULL || unitCount == 0 || model.rate < 0 || model.rate > 1 || model.loss < 0 ||
+      model.loss > 1) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  Scenario site;
+  std::string error;
+  if (!site.load(scenarioPath, error)) {
+    fprintf(stderr, "%s: %s\n", scenarioPath, error.c_str());
+    return 1;
+  }
+
+  WorkPool pool(threads);
+  if (grain == 0) {
+    grain = (unitCount + pool.threads() * 8 - 1) / (pool.threads() * 8); // a few chunks a thread to steal
+  }
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  std::vector<std::unique_ptr<Unit>> units(unitCount);
+  pool.parallelFor(unitCount, grain, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      units[i].reset(new Unit(site, seed * 1000003UL + i, intrudersPerDay));
+    }
+  });
+  std::chrono::duration<double> setup = std::chrono::steady_clock::now() - start;
+
+  printf("seconds,mean,min,max,critical,low,middle,near_full,full,sent,received\n");
+  ExchangeTotals exchanged = {0, 0};
+  ExchangeTotals sinceTrace = {0, 0};
+  std::vector<double> offers(unitCount);
+  unsigned long long nextTrace = 0;
+  unsigned long long now = 0;
+
+  std::chrono::duration<double> serial(0); // the calling thread alone: the trace and the exchange
+  start = std::chrono::steady_clock::now();
+  while (now < site.runMillis) {
+    std::chrono::steady_clock::time_point alone = std::chrono::steady_clock::now();
+    if (site.traceMillis != 0 && now >= nextTrace) {
+      trace(now / 1000.0, units, sinceTrace);
+      sinceTrace.sent = 0;
+      sinceTrace.received = 0;
+      nextTrace += site.traceMillis;
+    }
+    now += oneSecond;
+    serial += std::chrono::steady_clock::now() - alone;
+    pool.parallelFor(unitCount, grain, [&](size_t begin, size_t end) {
+      for (size_t i = begin; i < end; i++) {
+        units[i]->runUntil(now);
+      }
+    });
+    alone = std::chrono::steady_clock::now();
+    ExchangeTotals second = {0, 0};
+    exchangePower(units, model, offers, second);
+    exchanged.sent += second.sent;
+    exchanged.received += second.received;
+    sinceTrace.sent += second.sent;
+    sinceTrace.received += second.received;
+    serial += std::chrono::steady_clock::now() - alone;
+  }
+  trace(now / 1000.0, units, sinceTrace);
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  unsigned long long levelTicks[PowerFull + 1] = {0};
+  unsigned long long ticks = 0;
+  for (size_t i = 0; i < unitCount; i++) {
+    for (int level = PowerCritical; level <= PowerFull; level++) {
+      levelTicks[level] += units[i]->levelTicks[level];
+      ticks += units[i]->levelTicks[level];
+    }
+  }
+  static const char *const powerLevelNames[] = {"Critical", "Low", "Middle", "NearFull", "Full"};
+  double simulated = now / 1000.0;
+  fprintf(stderr, "units               %zu on %u threads, %zu a chunk\n", unitCount, pool.threads(), grain);
+  fprintf(stderr, "simulated           %.2f days\n", now / (double)scenarioMillisPerDay);
+  fprintf(stderr, "setup seconds       %.2f\n", setup.count());
+  fprintf(stderr, "host seconds        %.2f (%.0fx real time)\n", elapsed.count(), simulated / elapsed.count());
+  fprintf(stderr, "unit seconds/s      %.0f\n", simulated * unitCount / elapsed.count());
+  fprintf(stderr, "steals              %llu\n", pool.steals());
+  fprintf(stderr, "serial              %.2f%% of host time\n", 100.0 * serial.count() / elapsed.count());
+  fprintf(stderr, "exchanged           %.1f%% sent, %.1f%% received\n", exchanged.sent / fixedPercentScale,
+          exchanged.received / fixedPercentScale);
+  for (int level = PowerCritical; level <= PowerFull; level++) {
+    fprintf(stderr, "%-19s %.1f%%\n", powerLevelNames[level], ticks ? 100.0 * levelTicks[level] / ticks : 0.0);
+  }
+  return 0;
+}
@@ -0,0 +1,282 @@
+/*
+    scenario.cpp
+    2026-10-17
+
+    Scripted outside world for the dwelling simulator: sunlight, intruders, buttons and keys
+    Design notes are in the .h file
+*/
+
+#include "scenario.h"
+
+#include <Arduino.h>
+
+#include <fstream>
+#include <math.h>
+#include <sstream>
+
+#include "pins.h"
+
+const unsigned long long defaultPressMillis = 200;
+const unsigned long long keyIntervalMillis = 400;
+const unsigned long long keyHeldMillis = 200;
+const unsigned long long millisPerHour = 60ULL * 60 * 1000;
+
+Scenario::Scenario(void) {
+  runMillis = scenarioMillisPerDay;
+  traceMillis = millisPerHour;
+  _sequence = 0;
+  _night = 0;
+  _noon = 0;
+  _sunrise = 6 * millisPerHour;
+  _sunset = 18 * millisPerHour;
+  _clouds = false;
+  _cloudSeed = 0;
+}
+
+// <number><unit>
+static bool parseDuration(const std::string &text, unsigned long long &millis) {
+  char *unit;
+  double value = strtod(text.c_str(), &unit);
+  std::string suffix(unit);
+  double scale;
+  if (suffix.empty() && value == 0 && unit != text.c_str()) {
+    scale = 0; // plain 0 needs no unit
+  }
+  else if (suffix == "ms") {
+    scale = 1;
+  }
+  else if (suffix == "s") {
+    scale = 1000;
+  }
+  else if (suffix == "m") {
+    scale = 60000;
+  }
+  else if (suffix == "h") {
+    scale = millisPerHour;
+  }
+  else if (suffix == "d") {
+    scale = scenarioMillisPerDay;
+  }
+  else {
+    return false;
+  }
+  if (unit == text.c_str() || value < 0) {
+    return false;
+  }
+  millis = (unsigned long long)(value * scale + 0.5);
+  return true;
+}
+
+// [<day>.]<hh>:<mm>[:<ss>[.<mmm>]]
+static bool parseTime(const std::string &text, bool allowDay, unsigned long long &millis) {
+  unsigned long day = 0, hours = 0, minutes = 0, seconds = 0, thousandths = 0;
+  std::string clock = text;
+  size_t dot = text.find('.');
+  size_t colon = text.find(':');
+  if (dot != std::string::npos && dot < colon) {
+    if (!allowDay) {
+      return false;
+    }
+    day = strtoul(text.substr(0, dot).c_str(), NULL, 10);
+    clock = text.substr(dot + 1);
+  }
+  int fields = sscanf(clock.c_str(), "%lu:%lu:%lu.%lu", &hours, &minutes, &seconds, &thousandths);
+  if (fields < 2 || hours > 23 || minutes > 59 || seconds > 59 || thousandths > 999) {
+    return false;
+  }
+  millis = day * scenarioMillisPerDay + ((hours * 60 + minutes) * 60 + seconds) * 1000 + thousandths;
+  return true;
+}
+
+// <when>, or daily <when>; consumes the tokens it used
+static bool parseWhen(std::istringstream &in, unsigned long long &when, unsigned long long &repeatMillis) {
+  std::string token;
+  if (!(in >> token)) {
+    return false;
+  }
+  repeatMillis = 0;
+  if (token == "daily") {
+    repeatMillis = scenarioMillisPerDay;
+    if (!(in >> token)) {
+      return false;
+    }
+  }
+  return parseTime(token, repeatMillis == 0, when);
+}
+
+bool Scenario::load(const char *path, std::string &error) {
+  std::ifstream file(path);
+  if (!file) {
+    error = std::string("cannot read ") + path;
+    return false;
+  }
+  std::stringstream text;
+  text << file.rdbuf();
+  return parse(text.str(), error);
+}
+
+bool Scenario::parse(const std::string &text, std::string &error) {
+  std::istringstream lines(text);
+  std::string line;
+  for (int number = 1; std::getline(lines, line); number++) {
+    size_t comment = line.find('#');
+    if (comment != std::string::npos) {
+      line.erase(comment);
+    }
+    if (!parseLine(line, error)) {
+      std::ostringstream message;
+      message << "line " << number << ": " << error;
+      error = message.str();
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Scenario::parseLine(const std::string &line, std::string &error) {
+  std::istringstream in(line);
+  std::string statement;
+  if (!(in >> statement)) {
+    return true; // blank
+  }
+
+  std::string token;
+  unsigned long long when, repeatMillis, duration;
+  if (statement == "run" || statement == "trace") {
+    if (!(in >> token) || !parseDuration(token, duration)) {
+      error = "expected a duration such as 30d";
+      return false;
+    }
+    (statement == "run" ? runMillis : traceMillis) = duration;
+  }
+  else if (statement == "light") {
+    std::string sunrise, sunset;
+    if (!(in >> _night >> _noon >> sunrise >> sunset) || !parseTime(sunrise, false, _sunrise) ||
+        !parseTime(sunset, false, _sunset) || _sunrise >= _sunset) {
+      error = "expected light <night> <noon> <sunrise> <sunset> [clouds <seed>]";
+      return false;
+    }
+    _clouds = false;
+    if (in >> token) {
+      if (token != "clouds" || !(in >> _cloudSeed)) {
+        error = "expected clouds <seed>";
+        return false;
+      }
+      _clouds = true;
+    }
+    schedule(0, scenarioLightUpdateMillis, EventLight, 0, 0, 0);
+  }
+  else if (statement == "motion") {
+    if (!parseWhen(in, when, repeatMillis) || !(in >> token) || !parseDuration(token, duration)) {
+      error = "expected motion <when> <duration>";
+      return false;
+    }
+    schedule(when, repeatMillis, EventInput, intruderMotionAlarmPin, 0, HIGH);
+    schedule(when + duration, repeatMillis, EventInput, intruderMotionAlarmPin, 0, LOW);
+  }
+  else if (statement == "press") {
+    std::string button;
+    in >> button;
+    if ((button != "interior" && button != "exterior") || !parseWhen(in, when, repeatMillis)) {
+      error = "expected press interior|exterior <when> [<duration>]";
+      return false;
+    }
+    duration = defaultPressMillis;
+    if (in >> token && !parseDuration(token, duration)) {
+      error = "expected a duration such as 200ms";
+      return false;
+    }
+    uint8_t pin = button == "interior" ? interiorLightsButtonPin : exteriorLightsButtonPin;
+    schedule(when, repeatMillis, EventInput, pin, 0, LOW);
+    schedule(when + duration, repeatMillis, EventInput, pin, 0, HIGH);
+  }
+  else if (statement == "keys") {
+    if (!parseWhen(in, when, repeatMillis) || !(in >> token)) {
+      error = "expected keys <when> <keys>";
+      return false;
+    }
+    for (size_t i = 0; i < token.size(); i++) {
+      schedule(when + i * keyIntervalMillis, repeatMillis, EventKey, 0, token[i], HIGH);
+      schedule(when + i * keyIntervalMillis + keyHeldMillis, repeatMillis, EventKey, 0, token[i], LOW);
+    }
+  }
+  else {
+    error = "unknown statement " + statement;
+    return false;
+  }
+  return true;
+}
+
+void Scenario::schedule(unsigned long long when, unsigned long long repeatMillis, uint8_t type, uint8_t pin,
+                        char key, int level) {
+  Event event;
+  event.when = when;
+  event.sequence = _sequence++;
+  event.repeatMillis = repeatMillis;
+  event.type = type;
+  event.pin = pin;
+  event.key = key;
+  event.level = level;
+  _events.push(event);
+}
+
+void Scenario::runUntil(DwellingRig &rig, unsigned long long millis) {
+  while (!_events.empty() && _events.top().when <= millis) {
+    Event event = _events.top();
+    _events.pop();
+    if (rig.board.millis() < event.when) {
+      rig.board.advanceMicros((event.when - rig.board.millis()) * 1000);
+    }
+    apply(rig, event);
+    if (event.repeatMillis != 0) {
+      event.when += event.repeatMillis;
+      _events.push(event);
+    }
+  }
+}
+
+void Scenario::apply(DwellingRig &rig, const Event &event) {
+  switch (event.type) {
+  case EventInput:
+    rig.board.setInput(event.pin, event.level);
+    break;
+  case EventKey:
+    if (event.level == HIGH) {
+      rig.keypad.press(event.key);
+    }
+    else {
+      rig.keypad.release(event.key);
+    }
+    break;
+  case EventLight:
+    rig.board.setAnalogInput(solarArrayAnalogInputPin, lightAt(event.when));
+    break;
+  }
+}
+
+// repeatable noise in [0, 1) for an hour
+static double cloudCover(unsigned long seed, unsigned long long hour) {
+  uint32_t x = (uint32_t)(seed * 2654435761u) ^ (uint32_t)(hour * 40503u + 0x9E3779B9u);
+  x ^= x >> 16;
+  x *= 0x7FEB352Du;
+  x ^= x >> 15;
+  x *= 0x846CA68Bu;
+  x ^= x >> 16;
+  return (x & 0xFFFF) / 65536.0;
+}
+
+int Scenario::lightAt(unsigned long long millis) const {
+  unsigned long long timeOfDay = millis % scenarioMillisPerDay;
+  if (timeOfDay < _sunrise || timeOfDay >= _sunset) {
+    return _night;
+  }
+  double daylight = sin(M_PI * (timeOfDay - _sunrise) / (double)(_sunset - _sunrise));
+  if (_clouds) {
+    daylight *= 1.0 - 0.7 * cloudCover(_cloudSeed, millis / millisPerHour); // at worst 30% gets through
+  }
+  return _night + (int)((_noon - _night) * daylight + 0.5);
+}
+
+void Scenario::reseedClouds(unsigned long seed) {
+  _cloudSeed = seed;
+}
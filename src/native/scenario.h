@@ -0,0 +1,99 @@
+/*
+    scenario.h
+    2026-10-17
+
+    Scripted outside world for the dwelling simulator: sunlight, intruders, buttons and keys
+
+    A scenario is a text file, one statement per line; # starts a comment.
+        run <duration>                          how long to simulate (default 1d)
+        trace <duration>                        battery sample period in the trace (default 1h,
+                                                0 for transitions only)
+        light <night> <noon> <sunrise> <sunset> [clouds <seed>]
+                                                solar array ADC reading (0-1023): <night> until
+                                                sunrise, rising along half a sine to <noon> and
+                                                back by sunset; clouds dim each hour of daylight
+                                                by a repeatable pseudo-random amount
+        motion <when> <duration>                an intruder in view of the motion detector
+        press interior|exterior <when> [<duration>]
+                                                a light button held (default 200ms)
+        keys <when> <keys>                      typed on the keypad, one key per 400ms, each
+                                                held 200ms
+    <when> is [<day>.]<hh>:<mm>[:<ss>[.<mmm>]] from power on, or daily <hh>:<mm>[:<ss>] to
+        repeat every day.  <duration> is a number and a unit: ms, s, m, h or d.
+
+    Events are kept in time order and handed to the board by runUntil(), which moves the
+        simulated clock straight to each one; nothing waits in real time.  Sunlight is an event
+        too, recomputed once a simulated minute.
+*/
+
+#ifndef SCENARIO_H
+#define SCENARIO_H
+
+#include <stdint.h>
+
+#include <queue>
+#include <string>
+#include <vector>
+
+#include "dwelling_rig.h"
+
+const unsigned long long scenarioMillisPerDay = 24ULL * 60 * 60 * 1000;
+const unsigned long long scenarioLightUpdateMillis = 60000;
+
+class Scenario {
+public:
+  Scenario(void);
+
+  // false with a message naming the line on the first error
+  bool load(const char *path, std::string &error);
+  bool parse(const std::string &text, std::string &error);
+
+  // apply every event due at or before millis, in order
+  void runUntil(DwellingRig &rig, unsigned long long millis);
+  int lightAt(unsigned long long millis) const; // ADC reading
+  // the same sky over another unit: different clouds, if the scenario has any
+  void reseedClouds(unsigned long seed);
+
+  unsigned long long runMillis;
+  unsigned long long traceMillis;
+
+private:
+  typedef enum {
+    EventInput = 0, // drive pin to level
+    EventKey,       // press (level HIGH) or release key
+    EventLight      // recompute the sunlight
+  } EventType;
+
+  typedef struct {
+    unsigned long long when;
+    unsigned long sequence; // keeps events at the same time in script order
+    unsigned long long repeatMillis; // 0 for once
+    uint8_t type;
+    uint8_t pin;
+    char key;
+    int level;
+  } Event;
+
+  struct Later {
+    bool operator()(const Event &a, const Event &b) const {
+      return a.when != b.when ? a.when > b.when : a.sequence > b.sequence;
+    }
+  };
+
+  bool parseLine(const std::string &line, std::string &error);
+  void schedule(unsigned long long when, unsigned long long repeatMillis, uint8_t type, uint8_t pin, char key,
+                int level);
+  void apply(DwellingRig &rig, const Event &event);
+
+  std::priority_queue<Event, std::vector<Event>, Later> _events;
+  unsigned long _sequence;
+
+  int _night;
+  int _noon;
+  unsigned long long _sunrise; // millis into the day
+  unsigned long long _sunset;
+  bool _clouds;
+  unsigned long _cloudSeed;
+};
+
+#endif
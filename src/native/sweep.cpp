@@ -0,0 +1,392 @@
+/*
+    sweep.cpp
+    2026-10-17
+
+    Entry point for the power model parameter sweep (host build)
+
+    Tries HouseBattery's thresholds, its charge rate and the lights' loads against a set of
+        traces, scenario files with the sun and the intruders to test them on (see scenario.h).
+        Each parameter takes a single value or a range, <from>:<to>:<step>:
+            --critical, --low, --near-full, --charging   thresholds, percent
+            --divisor                                    a charging step adds solar / divisor
+            --interior, --exterior                       lights' loads per charging step, percent
+        Unset ones keep MegaPanel's value (see dwelling_config.h).  The runs are the grid of
+        every combination, or --sample of them picked at random; combinations whose thresholds
+        are out of order are skipped.
+    A combination runs every trace on a fresh TunableDwelling (see dwelling.h) and its own
+        simulated board, one combination per chunk of a work stealing pool (see work_pool.h);
+        TunablePanel's values are thread local, so each chunk sets them before building its
+        dwellings.  The results do not depend on the number of threads.
+
+    Per combination, over all its traces:
+        critical_time, low_time  share of the ticks at PowerCritical, at PowerLow
+        floodlights    share of the ticks with an intruder in view that had the floodlights on
+                       (empty when no trace has an intruder)
+        cycles_per_day battery cycles, the charge used over the battery's capacity, per day
+        mean_battery, min_battery   percent
+    As CSV on stdout, parameters first:
+        critical,low,near_full,charging,divisor,interior,exterior,critical_time,low_time,
+        floodlights,cycles_per_day,mean_battery,min_battery
+    or with --binary as a compact table, little endian:
+        header  "AKSW", uint16 version (1), uint16 record size (35), uint32 record count
+        record  uint16 critical, low, near_full, charging (FixedPercent), uint8 divisor,
+                uint16 interior, exterior (FixedPercent),
+                float critical_time, low_time, floodlights (NaN when no intruder),
+                cycles_per_day, mean_battery (percent), uint16 min_battery (FixedPercent)
+    A summary (runs, host time, speed, steals) goes to stderr.
+
+    usage: program [--critical <range>] [--low <range>] [--near-full <range>] [--charging <range>]
+                   [--divisor <range>] [--interior <range>] [--exterior <range>]
+                   [--sample <n>] [--seed <n>] [--threads <n, 0 for one per core>] [--binary]
+                   <scenario file>...
+*/
+
+#include <Arduino.h>
+
+#include <chrono>
+#include <math.h>
+#include <memory>
+#include <random>
+#include <set>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <vector>
+
+#include "dwelling.h"
+#include "dwelling_rig.h"
+#include "fixed_percent.h"
+#include "scenario.h"
+#include "sim_board.h"
+#include "work_pool.h"
+
+const unsigned long oneTenthOfASecond = 100L; // one 'tick', as in main.cpp
+
+typedef enum {
+  ParameterCritical,
+  ParameterLow,
+  ParameterNearFull,
+  ParameterCharging,
+  ParameterDivisor,
+  ParameterInterior,
+  ParameterExterior,
+  parameterCount
+} Parameter;
+
+typedef struct {
+  const char *option;
+  bool percent; // else a plain number, the divisor
+  unsigned minimum;
+  unsigned maximum;
+} ParameterSpec;
+
+static const ParameterSpec parameterSpecs[parameterCount] = {
+    {"--critical", true, 0, fixedPercent(100)}, {"--low", true, 0, fixedPercent(100)},
+    {"--near-full", true, 0, fixedPercent(100)}, {"--charging", true, 0, fixedPercent(100)},
+    {"--divisor", false, 1, 255},                {"--interior", true, 0, fixedPercent(100)},
+    {"--exterior", true, 0, fixedPercent(100)},
+};
+
+typedef struct {
+  unsigned values[parameterCount]; // FixedPercent, or the divisor
+} Combination;
+
+typedef struct {
+  unsigned long long ticks;
+  unsigned long long levelTicks[PowerFull + 1];
+  unsigned long long intruderTicks;
+  unsigned long long floodlitTicks; // of intruderTicks
+  unsigned long long used;          // charge, FixedPercent units
+  double batterySum;                // over ticks, FixedPercent units
+  FixedPercent lowest;
+} Outcome;
+
+// "<from>" or "<from>:<to>:<step>", into the values it covers, in the parameter's units
+static bool parseRange(const ParameterSpec &spec, const char *text, std::vector<unsigned> &values) {
+  double from, to, step;
+  char end;
+  int fields = sscanf(text, "%lf:%lf:%lf%c", &from, &to, &step, &end);
+  if (fields == 1) {
+    to = from;
+    step = 1;
+  }
+  else if (fields != 3 || step <= 0 || to < from) {
+    return false;
+  }
+  double scale = spec.percent ? fixedPercentScale : 1;
+  values.clear();
+  // a little slack so 0.5:2:0.5 reaches 2 despite the rounding
+  for (double value = from; value <= to + step * 1e-6; value += step) {
+    long scaled = lround(value * scale);
+    if (scaled < (long)spec.minimum || scaled > (long)spec.maximum) {
+      return false;
+    }
+    if (values.empty() || values.back() != (unsigned)scaled) {
+      values.push_back(scaled);
+    }
+  }
+  return !values.empty();
+}
+
+static Combination combinationAt(const std::vector<unsigned> (&ranges)[parameterCount], unsigned long long index) {
+  Combination combination;
+  for (int p = parameterCount - 1; p >= 0; p--) {
+    combination.values[p] = ranges[p][index % ranges[p].size()];
+    index /= ranges[p].size();
+  }
+  return combination;
+}
+
+static bool inOrder(const Combination &combination) {
+  const unsigned *v = combination.values;
+  return v[ParameterCritical] < v[ParameterLow] && v[ParameterLow] < v[ParameterNearFull] &&
+         v[ParameterNearFull] < v[ParameterCharging];
+}
+
+// TunablePanel's values for this thread's dwellings
+static void configure(const Combination &combination) {
+  const unsigned *v = combination.values;
+  TunablePanel::criticalThreshold = v[ParameterCritical];
+  TunablePanel::lowThreshold = v[ParameterLow];
+  TunablePanel::prettyFullThreshold = v[ParameterNearFull];
+  TunablePanel::chargingThreshold = v[ParameterCharging];
+  TunablePanel::solarChargeDivisor = v[ParameterDivisor];
+  TunablePanel::interiorLightsPowerUsage = v[ParameterInterior];
+  TunablePanel::exteriorLightsPowerUsage = v[ParameterExterior];
+}
+
+// one trace on a fresh board, added to outcome
+static void run(const Scenario &trace, Outcome &outcome) {
+  SimBoard board;
+  SimBoard::Scope scope(board);
+  Scenario scenario(trace);
+  DwellingRig rig(board);
+  std::unique_ptr<TunableDwelling> dwelling(new TunableDwelling());
+  dwelling->init();
+
+  BasicHouseBattery<TunablePanel> &battery = dwelling->_electricalStorage;
+  unsigned long long nextTick = board.millis();
+  int tick = 0;
+  while (nextTick < scenario.runMillis) {
+    scenario.runUntil(rig, nextTick);
+    if (board.millis() < nextTick) {
+      board.advanceMicros((nextTick - board.millis()) * 1000);
+    }
+    FixedPercent before = battery.batteryLevel();
+    dwelling->tick(++tick);
+    FixedPercent level = battery.batteryLevel();
+
+    outcome.ticks++;
+    outcome.levelTicks[battery.powerLevel()]++;
+    if (dwelling->_intruderAlarm.isOn()) {
+      outcome.intruderTicks++;
+      if (dwelling->_exteriorLights.isOn()) {
+        outcome.floodlitTicks++;
+      }
+    }
+    if (level < before) {
+      outcome.used += before - level;
+    }
+    outcome.batterySum += level;
+    outcome.lowest = level < outcome.lowest ? level : outcome.lowest;
+    nextTick += oneTenthOfASecond;
+  }
+}
+
+static void writeCsv(const std::vector<Combination> &combinations, const std::vector<Outcome> &outcomes) {
+  printf("critical,low,near_full,charging,divisor,interior,exterior,critical_time,low_time,floodlights,"
+         "cycles_per_day,mean_battery,min_battery\n");
+  for (size_t i = 0; i < combinations.size(); i++) {
+    const unsigned *v = combinations[i].values;
+    const Outcome &o = outcomes[i];
+    double days = o.ticks * oneTenthOfASecond / (double)scenarioMillisPerDay;
+    printf("%.2f,%.2f,%.2f,%.2f,%u,%.2f,%.2f,%.4f,%.4f,", (double)v[ParameterCritical] / fixedPercentScale,
+           (double)v[ParameterLow] / fixedPercentScale, (double)v[ParameterNearFull] / fixedPercentScale,
+           (double)v[ParameterCharging] / fixedPercentScale, v[ParameterDivisor],
+           (double)v[ParameterInterior] / fixedPercentScale, (double)v[ParameterExterior] / fixedPercentScale,
+           (double)o.levelTicks[PowerCritical] / o.ticks, (double)o.levelTicks[PowerLow] / o.ticks);
+    if (o.intruderTicks != 0) {
+      printf("%.4f", (double)o.floodlitTicks / o.intruderTicks);
+    }
+    printf(",%.3f,%.2f,%.2f\n", o.used / (double)MegaPanel::maximumBatteryPower / days,
+           o.batterySum / o.ticks / fixedPercentScale, (double)o.lowest / fixedPercentScale);
+  }
+}
+
+static void put16(uint16_t value) {
+  putchar(value & 0xFF);
+  putchar(value >> 8);
+}
+
+static void put32(uint32_t value) {
+  put16(value & 0xFFFF);
+  put16(value >> 16);
+}
+
+static void putFloat(float value) {
+  uint32_t bits;
+  memcpy(&bits, &value, sizeof(bits));
+  put32(bits);
+}
+
+static void writeBinary(const std::vector<Combination> &combinations, const std::vector<Outcome> &outcomes) {
+  fputs("AKSW", stdout);
+  put16(1);  // version
+  put16(35); // record size
+  put32(combinations.size());
+  for (size_t i = 0; i < combinations.size(); i++) {
+    const unsigned *v = combinations[i].values;
+    const Outcome &o = outcomes[i];
+    double days = o.ticks * oneTenthOfASecond / (double)scenarioMillisPerDay;
+    put16(v[ParameterCritical]);
+    put16(v[ParameterLow]);
+    put16(v[ParameterNearFull]);
+    put16(v[ParameterCharging]);
+    putchar(v[ParameterDivisor]);
+    put16(v[ParameterInterior]);
+    put16(v[ParameterExterior]);
+    putFloat((double)o.levelTicks[PowerCritical] / o.ticks);
+    putFloat((double)o.levelTicks[PowerLow] / o.ticks);
+    putFloat(o.intruderTicks != 0 ? (double)o.floodlitTicks / o.intruderTicks : NAN);
+    putFloat(o.used / (double)MegaPanel::maximumBatteryPower / days);
+    putFloat(o.batterySum / o.ticks / fixedPercentScale);
+    put16(o.lowest);
+  }
+}
+
+static void usage(const char *program) {
+  fprintf(stderr,
+          "usage: %s [--critical <range>] [--low <range>] [--near-full <range>] [--charging <range>]\n"
+          "          [--divisor <range>] [--interior <range>] [--exterior <range>]\n"
+          "          [--sample <n>] [--seed <n>] [--threads <n, 0 for one per core>] [--binary]\n"
+          "          <scenario file>...\n"
+          "  a range is <from> or <from>:<to>:<step>, in percent but for the divisor\n",
+          program);
+}
+
+int main(int argc, char **argv) {
+  std::vector<unsigned> ranges[parameterCount] = {
+      {MegaPanel::criticalThreshold},  {MegaPanel::lowThreshold},
+      {MegaPanel::prettyFullThreshold}, {MegaPanel::chargingThreshold},
+      {MegaPanel::solarChargeDivisor}, {MegaPanel::interiorLightsPowerUsage},
+      {MegaPanel::exteriorLightsPowerUsage},
+  };
+  unsigned long long sample = 0;
+  unsigned long seed = 1;
+  unsigned threads = 0;
+  bool binary = false;
+  std::vector<const char *> tracePaths;
+  for (int i = 1; i < argc; i++) {
+    bool value = i + 1 < argc;
+    int parameter = parameterCount;
+    for (int p = 0; p < parameterCount; p++) {
+      if (strcmp(argv[i], parameterSpecs[p].option) == 0) {
+        parameter = p;
+      }
+    }
+    if (parameter != parameterCount && value) {
+      if (!parseRange(parameterSpecs[parameter], argv[++i], ranges[parameter])) {
+        fprintf(stderr, "%s: bad range %s\n", parameterSpecs[parameter].option, argv[i]);
+        return 2;
+      }
+    }
+    else if (strcmp(argv[i], "--sample") == 0 && value) {
+      sample = strtoull(argv[++i], NULL, 10);
+    }
+    else if (strcmp(argv[i], "--seed") == 0 && value) {
+      seed = strtoul(argv[++i], NULL, 10);
+    }
+    else if (strcmp(argv[i], "--threads") == 0 && value) {
+      threads = strtoul(argv[++i], NULL, 10);
+    }
+    else if (strcmp(argv[i], "--binary") == 0) {
+      binary = true;
+    }
+    else if (argv[i][0] != '-') {
+      tracePaths.push_back(argv[i]);
+    }
+    else {
+      usage(argv[0]);
+      return 2;
+    }
+  }
+  if (tracePaths.empty()) {
+    usage(argv[0]);
+    return 2;
+  }
+
+  std::vector<Scenario> traces(tracePaths.size());
+  for (size_t i = 0; i < tracePaths.size(); i++) {
+    std::string error;
+    if (!traces[i].load(tracePaths[i], error)) {
+      fprintf(stderr, "%s: %s\n", tracePaths[i], error.c_str());
+      return 1;
+    }
+  }
+
+  unsigned long long gridSize = 1;
+  for (int p = 0; p < parameterCount; p++) {
+    gridSize *= ranges[p].size();
+  }
+  // the grid, or sample distinct points of it (Floyd's algorithm), in grid order either way
+  std::set<unsigned long long> picked;
+  if (sample != 0 && sample < gridSize) {
+    std::mt19937_64 random(seed);
+    for (unsigned long long j = gridSize - sample; j < gridSize; j++) {
+      unsigned long long index = std::uniform_int_distribution<unsigned long long>(0, j)(random);
+      if (!picked.insert(index).second) {
+        picked.insert(j);
+      }
+    }
+  }
+  else {
+    for (unsigned long long index = 0; index < gridSize; index++) {
+      picked.insert(index);
+    }
+  }
+  std::vector<Combination> combinations;
+  for (std::set<unsigned long long>::const_iterator index = picked.begin(); index != picked.end(); ++index) {
+    Combination combination = combinationAt(ranges, *index);
+    if (inOrder(combination)) {
+      combinations.push_back(combination);
+    }
+  }
+  size_t skipped = picked.size() - combinations.size();
+
+  WorkPool pool(threads);
+  std::vector<Outcome> outcomes(combinations.size());
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  pool.parallelFor(combinations.size(), 1, [&](size_t begin, size_t end) {
+    for (size_t i = begin; i < end; i++) {
+      configure(combinations[i]);
+      Outcome &outcome = outcomes[i];
+      memset(&outcome, 0, sizeof(outcome));
+      outcome.lowest = MegaPanel::maximumBatteryPower;
+      for (size_t t = 0; t < traces.size(); t++) {
+        run(traces[t], outcome);
+      }
+    }
+  });
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+  if (binary) {
+    writeBinary(combinations, outcomes);
+  }
+  else {
+    writeCsv(combinations, outcomes);
+  }
+
+  double simulated = 0;
+  for (size_t t = 0; t < traces.size(); t++) {
+    simulated += traces[t].runMillis / 1000.0;
+  }
+  simulated *= combinations.size();
+  fprintf(stderr, "combinations        %zu of %llu (%zu out of order)\n", combinations.size(), gridSize, skipped);
+  fprintf(stderr, "traces              %zu\n", traces.size());
+  fprintf(stderr, "threads             %u\n", pool.threads());
+  fprintf(stderr, "host seconds        %.2f\n", elapsed.count());
+  fprintf(stderr, "dwelling seconds/s  %.0f\n", elapsed.count() > 0 ? simulated / elapsed.count() : 0.0);
+  fprintf(stderr, "steals              %llu\n", pool.steals());
+  return 0;
+}
@@ -0,0 +1,241 @@
+/*
+    telemetry_decode.cpp
+    2026-10-17
+
+    Entry point for the telemetry decoder (host build)
+
+    Reads a captured telemetry stream (see telemetry.h), from a file or stdin, and writes it to
+        stdout as CSV, one row per record:
+        seconds,record,tick,battery,solar,power,interior,exterior,alert,motion,interior_button,
+            exterior_button,charging,unlocked,sounding,alarm,event,value
+            seconds     since boot: the tick count for ticks (unwrapped), millis() for events
+            record      tick or event
+            tick .. alarm   tick records only; battery and solar in percent, the flags 0 or 1
+            event, value    event records only
+    A capture from the board is the raw port, for example
+        stty -F /dev/ttyACM0 115200 raw && cat /dev/ttyACM0 > capture.bin
+    or the simulator's (see dwelling_sim.cpp).  Counts of frames, bad frames (a capture that
+        starts mid-frame has one) and frames the dwelling reported dropping go to stderr.
+    So do the profile build's reports, as text (format in profiler.h), each headed by the tick
+        its window closed on.
+
+    usage: program [capture file]
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "fixed_percent.h"
+#include "profiler.h"
+#include "telemetry.h"
+
+const unsigned long millisPerTick = 100;
+
+static const char *const powerLevelNames[] = {"Critical", "Low", "Middle", "NearFull", "Full"};
+static const char *const alarmNames[] = {"none", "alert", "power_critical", "power_low"};
+static const char *const eventNames[] = {
+    "", "setup_complete", "unlocked", "bad_code", "locked_out", "alarm", "unknown_alarm_signal", "dropped",
+};
+static const char *const pointNames[profilePointCount] = {
+    "lighting", "charging", "motion", "display", "batteryLight", "unlock",
+    "inputs", "telemetry", "journal", "tick", "slack",
+};
+
+const uint8_t profileMaxBuckets = 32; // more than the firmware keeps
+
+typedef struct {
+  bool seen;
+  TelemetryProfileRecord summary;
+  uint16_t histogram[profileMaxBuckets];
+  uint8_t used;
+} PointReport;
+
+// the profile window being collected
+typedef struct {
+  bool open;
+  TelemetryDutyCycleRecord dutyCycle;
+  PointReport points[profilePointCount];
+} ProfileWindow;
+
+typedef struct {
+  unsigned long frames;
+  unsigned long badFrames;
+  unsigned long droppedFrames;
+  unsigned long long ticks; // unwrapped
+  bool seenTick;
+  uint16_t lastTick;
+  ProfileWindow profile;
+} DecodeState;
+
+static int flag(uint16_t flags, uint16_t mask) {
+  return (flags & mask) != 0;
+}
+
+static void decodeTick(const TelemetryTickRecord &record, DecodeState &state) {
+  if (!state.seenTick) {
+    state.ticks = record.tickCount;
+    state.seenTick = true;
+  }
+  else {
+    state.ticks += (uint16_t)(record.tickCount - state.lastTick);
+  }
+  state.lastTick = record.tickCount;
+
+  const char *power = record.powerLevel < sizeof(powerLevelNames) / sizeof(powerLevelNames[0])
+                          ? powerLevelNames[record.powerLevel]
+                          : "?";
+  const char *alarm = record.alarm < sizeof(alarmNames) / sizeof(alarmNames[0]) ? alarmNames[record.alarm] : "?";
+  printf("%.1f,tick,%llu,%.2f,%.2f,%s,%d,%d,%d,%d,%d,%d,%d,%d,%d,%s,,\n", state.ticks * millisPerTick / 1000.0,
+         state.ticks, (double)record.battery / fixedPercentScale, (double)record.solar / fixedPercentScale, power,
+         flag(record.flags, telemetryInteriorLights), flag(record.flags, telemetryExteriorLights),
+         flag(record.flags, telemetryAlertLight), flag(record.flags, telemetryMotion),
+         flag(record.flags, telemetryInteriorButton), flag(record.flags, telemetryExteriorButton),
+         flag(record.flags, telemetryCharging), flag(record.flags, telemetryUnlocked),
+         flag(record.flags, telemetrySounding), alarm);
+}
+
+static void decodeEvent(const TelemetryEventRecord &record, DecodeState &state) {
+  if (record.code == TelemetryDropped) {
+    state.droppedFrames += record.value;
+  }
+  const char *name = record.code < sizeof(eventNames) / sizeof(eventNames[0]) ? eventNames[record.code] : "";
+  if (name[0] == 0) {
+    printf("%.3f,event,,,,,,,,,,,,,,,%u,%d\n", record.millis / 1000.0, record.code, record.value);
+  }
+  else {
+    printf("%.3f,event,,,,,,,,,,,,,,,%s,%d\n", record.millis / 1000.0, name, record.value);
+  }
+}
+
+static void printProfile(ProfileWindow &window) {
+  if (!window.open) {
+    return;
+  }
+  fprintf(stderr, "profile at tick %u\n", window.dutyCycle.tickCount);
+  for (uint8_t point = 0; point < profilePointCount; point++) {
+    const PointReport &report = window.points[point];
+    if (!report.seen) {
+      continue;
+    }
+    const TelemetryProfileRecord &summary = report.summary;
+    fprintf(stderr, "P %s n=%u avg=%lu max=%lu h=", pointNames[point], summary.count,
+            summary.count != 0 ? (unsigned long)summary.total / summary.count : 0UL,
+            (unsigned long)summary.maximum);
+    uint8_t used = report.used;
+    while (used > 1 && report.histogram[used - 1] == 0) { // the last record's padding
+      used--;
+    }
+    for (uint8_t bucket = 0; bucket < used; bucket++) {
+      fprintf(stderr, bucket ? ",%u" : "%u", report.histogram[bucket]);
+    }
+    fprintf(stderr, "\n");
+  }
+  fprintf(stderr, "I awake=%lu asleep=%lu\n", (unsigned long)window.dutyCycle.awake,
+          (unsigned long)window.dutyCycle.asleep);
+  memset(&window, 0, sizeof(window));
+}
+
+// false if the record does not belong to the window being collected
+static bool decodeProfile(const uint8_t *record, uint8_t size, ProfileWindow &window) {
+  if (size == sizeof(TelemetryDutyCycleRecord) && record[0] == TelemetryDutyCycle) {
+    printProfile(window);
+    window.open = true;
+    memcpy(&window.dutyCycle, record, sizeof(window.dutyCycle));
+    return true;
+  }
+  if (!window.open || size < 2 || record[1] >= profilePointCount) {
+    return false;
+  }
+  PointReport &report = window.points[record[1]];
+  if (size == sizeof(TelemetryProfileRecord) && record[0] == TelemetryProfile) {
+    report.seen = true;
+    memcpy(&report.summary, record, sizeof(report.summary));
+    return true;
+  }
+  if (size == sizeof(TelemetryHistogramRecord) && record[0] == TelemetryHistogram) {
+    TelemetryHistogramRecord histogram;
+    memcpy(&histogram, record, sizeof(histogram));
+    if (!report.seen || histogram.first + telemetryHistogramBuckets > profileMaxBuckets) {
+      return false;
+    }
+    memcpy(&report.histogram[histogram.first], histogram.buckets, sizeof(histogram.buckets));
+    report.used = histogram.first + telemetryHistogramBuckets;
+    return true;
+  }
+  return false;
+}
+
+static void decodeFrame(const uint8_t *frame, uint8_t length, DecodeState &state) {
+  uint8_t record[telemetryMaxRecord];
+  uint8_t size = Telemetry::decodeFrame(frame, length, record, telemetryMaxRecord);
+  if (size == sizeof(TelemetryTickRecord) && record[0] == TelemetryTick) {
+    TelemetryTickRecord tick;
+    memcpy(&tick, record, sizeof(tick));
+    decodeTick(tick, state);
+  }
+  else if (size == sizeof(TelemetryEventRecord) && record[0] == TelemetryEvent) {
+    TelemetryEventRecord event;
+    memcpy(&event, record, sizeof(event));
+    decodeEvent(event, state);
+  }
+  else if (size != 0 && record[0] >= TelemetryProfile) {
+    if (!decodeProfile(record, size, state.profile)) {
+      state.badFrames++;
+      return;
+    }
+  }
+  else {
+    state.badFrames++;
+    return;
+  }
+  state.frames++;
+}
+
+int main(int argc, char **argv) {
+  if (argc > 2) {
+    fprintf(stderr, "usage: %s [capture file]\n", argv[0]);
+    return 2;
+  }
+  FILE *in = argc == 2 ? fopen(argv[1], "rb") : stdin;
+  if (in == NULL) {
+    fprintf(stderr, "cannot read %s\n", argv[1]);
+    return 1;
+  }
+
+  printf("seconds,record,tick,battery,solar,power,interior,exterior,alert,motion,interior_button,exterior_button,"
+         "charging,unlocked,sounding,alarm,event,value\n");
+  DecodeState state;
+  memset(&state, 0, sizeof(state));
+  uint8_t frame[telemetryMaxFrame];
+  uint8_t length = 0;
+  bool overlong = false;
+  int c;
+  while ((c = getc(in)) != EOF) {
+    if (c != 0) {
+      if (length < sizeof(frame)) {
+        frame[length++] = c;
+      }
+      else {
+        overlong = true;
+      }
+      continue;
+    }
+    if (overlong) {
+      state.badFrames++;
+    }
+    else if (length != 0) {
+      decodeFrame(frame, length, state);
+    }
+    length = 0;
+    overlong = false;
+  }
+  if (in != stdin) {
+    fclose(in);
+  }
+  printProfile(state.profile);
+
+  fprintf(stderr, "frames              %lu\n", state.frames);
+  fprintf(stderr, "bad frames          %lu\n", state.badFrames);
+  fprintf(stderr, "dropped (reported)  %lu\n", state.droppedFrames);
+  return 0;
+}
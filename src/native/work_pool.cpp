@@ -0,0 +1,133 @@
+/*
+    work_pool.cpp
+    2026-10-17
+
+    Work stealing thread pool for the host programs
+    Design notes are in the .h file
+*/
+
+#include "work_pool.h"
+
+WorkPool::WorkPool(unsigned threads) :
+    _generation(0), _stopping(false), _body(NULL), _remaining(0) {
+  if (threads == 0) {
+    threads = std::thread::hardware_concurrency();
+  }
+  if (threads == 0) {
+    threads = 1;
+  }
+  for (unsigned i = 0; i < threads; i++) {
+    _workers.push_back(new Worker);
+  }
+  for (unsigned i = 1; i < threads; i++) {
+    _workers[i]->thread = std::thread(&WorkPool::serve, this, i);
+  }
+}
+
+WorkPool::~WorkPool(void) {
+  {
+    std::lock_guard<std::mutex> guard(_lock);
+    _stopping = true;
+  }
+  _wake.notify_all();
+  for (size_t i = 0; i < _workers.size(); i++) {
+    if (_workers[i]->thread.joinable()) {
+      _workers[i]->thread.join();
+    }
+    delete _workers[i];
+  }
+}
+
+void WorkPool::parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)> &body) {
+  if (count == 0) {
+    return;
+  }
+  if (grain == 0) {
+    grain = 1;
+  }
+  size_t chunks = (count + grain - 1) / grain;
+  // set before any chunk is dealt: a worker still looking for work may take one straight away
+  _body = &body;
+  _remaining = chunks;
+
+  size_t workers = _workers.size();
+  for (size_t w = 0; w < workers; w++) {
+    Worker &worker = *_workers[w];
+    std::lock_guard<std::mutex> guard(worker.lock);
+    for (size_t c = chunks * w / workers; c < chunks * (w + 1) / workers; c++) {
+      Chunk chunk;
+      chunk.begin = c * grain;
+      chunk.end = c * grain + grain < count ? c * grain + grain : count;
+      worker.chunks.push_back(chunk);
+    }
+  }
+  {
+    std::lock_guard<std::mutex> guard(_lock);
+    _generation++;
+  }
+  _wake.notify_all();
+
+  work(0);
+  std::unique_lock<std::mutex> lock(_lock);
+  _done.wait(lock, [this] { return _remaining == 0; });
+  _body = NULL;
+}
+
+unsigned long long WorkPool::steals(void) const {
+  unsigned long long total = 0;
+  for (size_t i = 0; i < _workers.size(); i++) {
+    total += _workers[i]->steals;
+  }
+  return total;
+}
+
+void WorkPool::work(unsigned self) {
+  Chunk chunk;
+  while (take(self, chunk)) {
+    (*_body)(chunk.begin, chunk.end);
+    if (--_remaining == 0) {
+      std::lock_guard<std::mutex> guard(_lock);
+      _done.notify_all();
+    }
+  }
+}
+
+void WorkPool::serve(unsigned self) {
+  unsigned long seen = 0;
+  for (;;) {
+    {
+      std::unique_lock<std::mutex> lock(_lock);
+      _wake.wait(lock, [this, seen] { return _stopping || _generation != seen; });
+      if (_stopping) {
+        return;
+      }
+      seen = _generation;
+    }
+    work(self);
+  }
+}
+
+// the front of our own queue, else the back of the next one along that has any
+bool WorkPool::take(unsigned self, Chunk &chunk) {
+  Worker &own = *_workers[self];
+  {
+    std::lock_guard<std::mutex> guard(own.lock);
+    if (!own.chunks.empty()) {
+      chunk = own.chunks.front();
+      own.chunks.pop_front();
+      return true;
+    }
+  }
+  size_t workers = _workers.size();
+  for (size_t i = 1; i < workers; i++) {
+    Worker &victim = *_workers[(self + i) % workers];
+    std::lock_guard<std::mutex> guard(victim.lock);
+    if (!victim.chunks.empty()) {
+      chunk = victim.chunks.back();
+      victim.chunks.pop_back();
+      own.steals++;
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,77 @@
+/*
+    work_pool.h
+    2026-10-17
+
+    Work stealing thread pool for the host programs
+
+    parallelFor(count, grain, body) cuts [0, count) into chunks of grain items, deals them out
+        to the workers' queues in contiguous runs, and returns once body(begin, end) has been
+        called for every chunk.  Each worker takes chunks from the front of its own queue; one
+        that runs dry steals from the back of another's, so a worker whose chunks happen to be
+        slow (an intruder, a busy LCD) does not hold the rest up.  The calling thread works too,
+        so a pool of one thread runs everything in place.
+    Chunks of one call may run in any order, on any thread; body must only touch what its items
+        own (a dwelling and its board, say).  Calls do not overlap: the next one starts after
+        the last chunk of this one has finished.
+
+    Each queue has its own lock, held only to take or deal a chunk; chunks of a few hundred
+        microseconds or more make its cost disappear.
+*/
+
+#ifndef WORK_POOL_H
+#define WORK_POOL_H
+
+#include <stddef.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+class WorkPool {
+public:
+  // 0 threads: one per core
+  explicit WorkPool(unsigned threads);
+  ~WorkPool(void);
+  WorkPool(const WorkPool &) = delete;
+  WorkPool &operator=(const WorkPool &) = delete;
+
+  void parallelFor(size_t count, size_t grain, const std::function<void(size_t begin, size_t end)> &body);
+
+  unsigned threads(void) const {
+    return _workers.size();
+  }
+  unsigned long long steals(void) const; // chunks run by a worker other than the one dealt them
+
+private:
+  typedef struct {
+    size_t begin;
+    size_t end;
+  } Chunk;
+
+  struct Worker {
+    std::mutex lock;
+    std::deque<Chunk> chunks;
+    unsigned long long steals = 0;
+    std::thread thread;
+  };
+
+  void work(unsigned self);       // until this call's chunks are gone
+  void serve(unsigned self);      // a worker thread's life
+  bool take(unsigned self, Chunk &chunk);
+
+  std::vector<Worker *> _workers; // [0] is the calling thread
+
+  std::mutex _lock;
+  std::condition_variable _wake;
+  std::condition_variable _done;
+  unsigned long _generation; // one per parallelFor()
+  bool _stopping;
+  const std::function<void(size_t, size_t)> *_body;
+  std::atomic<size_t> _remaining; // chunks not yet finished
+};
+
+#endif
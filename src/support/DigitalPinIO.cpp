@@ -9,6 +9,8 @@
 #include <Arduino.h>
 
 // DigitalPinIn
+BoardLocal<DigitalPinIn::InterruptInputs> DigitalPinIn::_interruptInputs;
+
 DigitalPinIn::DigitalPinIn(uint8_t pin, bool pullup = DigitalPinIO::withoutPullup,
                            bool highIsOn = DigitalPinIO::highOn) {
   _pin = pin;
@@ -19,6 +21,57 @@ DigitalPinIn::DigitalPinIn(uint8_t pin, bool pullup = DigitalPinIO::withoutPullu
 
   _lastReadValue = _highIsOn ? LOW : HIGH;
   _valueHasChanged = false;
+  _wasOn = false;
+  _channel = -1;
+  _turnedOn = 0;
+  _held = false;
+}
+
+bool DigitalPinIn::useInterrupts(uint8_t debounceMillis, uint16_t longPressMillis) {
+  int8_t channel = InputEngine::attach(_pin, _highIsOn, debounceMillis, longPressMillis);
+  if (channel < 0) {
+    return false;
+  }
+  _interruptInputs->inputs[channel] = this;
+  _channel = channel;
+  return true;
+}
+
+bool DigitalPinIn::wasTurnedOn(void) {
+  if (_channel < 0) {
+    bool on = isOn();
+    bool turnedOn = on && !_wasOn;
+    _wasOn = on;
+    return turnedOn;
+  }
+  if (_turnedOn == 0) {
+    return false;
+  }
+  _turnedOn--;
+  return true;
+}
+
+bool DigitalPinIn::wasHeld(void) {
+  bool held = _held;
+  _held = false;
+  return held;
+}
+
+void DigitalPinIn::dispatchEvents(void) {
+  InterruptInputs &interruptInputs = *_interruptInputs;
+  InputEvent event;
+  while (InputEngine::read(event)) {
+    DigitalPinIn *input = interruptInputs.inputs[event.source];
+    if (input == NULL) {
+      continue;
+    }
+    if (event.payload == InputTurnedOn && input->_turnedOn < 255) {
+      input->_turnedOn++;
+    }
+    else if (event.payload == InputHeld) {
+      input->_held = true;
+    }
+  }
 }
 
 bool DigitalPinIn::isOn(void) {
@@ -35,8 +88,13 @@ bool DigitalPinIn::hasChanged(void) {
 }
 
 int DigitalPinIn::value(void) {
-  // TBD debounce
-  int currentValue = digitalRead(_pin);
+  int currentValue;
+  if (_channel < 0) {
+    currentValue = digitalRead(_pin); // not debounced
+  }
+  else {
+    currentValue = InputEngine::isOn(_channel) == _highIsOn ? HIGH : LOW;
+  }
   _valueHasChanged = (_lastReadValue != currentValue);
   _lastReadValue = currentValue;
   return currentValue;
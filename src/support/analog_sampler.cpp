@@ -0,0 +1,167 @@
+/*
+    analog_sampler.cpp
+    2026-10-17
+
+    Interrupt driven analog inputs: oversampled, decimated and smoothed in the background
+    Design notes are in the .h file
+*/
+
+#include "analog_sampler.h"
+
+#include <Arduino.h>
+
+#include "board_local.h"
+
+#ifdef __AVR__
+#include <avr/interrupt.h>
+#else
+#include "sim_board.h"
+#endif
+
+const uint8_t decimationShift = 2; // 16 conversions of 10 bits -> 12 bits
+const uint8_t filterShift = 2;     // new = old + (sample - old) / 4
+
+typedef struct {
+  uint8_t pin;
+  uint8_t conversions;
+  uint16_t sum;
+  uint16_t filtered; // value << filterShift
+} AnalogChannel;
+
+struct AnalogSamplerState {
+  // Channels are only written by attach() and begin(); after that they belong to the interrupt
+  AnalogChannel channels[analogMaxChannels];
+  uint8_t channelCount = 0;
+  uint8_t converting = 0; // channel of the conversion in progress
+#ifndef __AVR__
+  unsigned long nextConversion = 0; // micros()
+#endif
+};
+
+static BoardLocal<AnalogSamplerState> sampler;
+
+#ifdef __AVR__
+static void selectChannel(AnalogSamplerState &state, uint8_t channel) {
+  uint8_t pin = state.channels[channel].pin;
+  if (pin >= A0) {
+    pin -= A0;
+  }
+  ADCSRB = (ADCSRB & ~_BV(MUX5)) | (((pin >> 3) & 0x01) << MUX5);
+  ADMUX = (DEFAULT << 6) | (pin & 0x07);
+}
+#endif
+
+static void decimate(AnalogChannel &input) {
+  uint16_t sample = input.sum >> decimationShift;
+  input.filtered += sample - (input.filtered >> filterShift); // wraps back into range
+  input.sum = 0;
+  input.conversions = 0;
+}
+
+#ifdef __AVR__
+
+ISR(ADC_vect) {
+  AnalogSamplerState &state = *sampler;
+  AnalogChannel &input = state.channels[state.converting];
+  input.sum += ADC;
+  if (++input.conversions == analogOversample) {
+    decimate(input);
+  }
+  if (++state.converting >= state.channelCount) {
+    state.converting = 0;
+  }
+  selectChannel(state, state.converting); // for the next trigger, a millisecond away
+}
+
+#else
+
+// conversions of a reading that held steady, a block at a time
+static void convertSteady(AnalogChannel &input, int reading, unsigned long conversions) {
+  while (conversions > 0) {
+    uint8_t take = analogOversample - input.conversions;
+    if (conversions < take) {
+      take = conversions;
+    }
+    bool wholeBlock = take == analogOversample;
+    input.sum += take * reading;
+    input.conversions += take;
+    conversions -= take;
+    if (input.conversions == analogOversample) {
+      uint16_t previous = input.filtered;
+      decimate(input);
+      if (wholeBlock && input.filtered == previous) {
+        conversions %= analogOversample; // settled: more whole blocks change nothing
+      }
+    }
+  }
+}
+
+// run the conversions the ADC would have made since the last call
+static void catchUp(AnalogSamplerState &state) {
+  unsigned long now = micros();
+  if ((long)(now - state.nextConversion) < 0) {
+    return;
+  }
+  unsigned long owed = (now - state.nextConversion) / analogConversionMicros + 1;
+  state.nextConversion += owed * analogConversionMicros;
+  for (uint8_t i = 0; i < state.channelCount && i < owed; i++) {
+    AnalogChannel &input = state.channels[(state.converting + i) % state.channelCount];
+    convertSteady(input, analogRead(input.pin), (owed - 1 - i) / state.channelCount + 1);
+  }
+  state.converting = (state.converting + owed) % state.channelCount;
+}
+
+static void analogChanged(void) {
+  catchUp(*sampler);
+}
+
+#endif
+
+int8_t AnalogSampler::attach(uint8_t pin) {
+  AnalogSamplerState &state = *sampler;
+  if (state.channelCount >= analogMaxChannels) {
+    return -1;
+  }
+  AnalogChannel &input = state.channels[state.channelCount];
+  input.pin = pin;
+  input.conversions = 0;
+  input.sum = 0;
+  input.filtered = 0;
+  return state.channelCount++;
+}
+
+void AnalogSampler::begin(void) {
+  AnalogSamplerState &state = *sampler;
+  if (state.channelCount == 0) {
+    return;
+  }
+  for (uint8_t channel = 0; channel < state.channelCount; channel++) {
+    AnalogChannel &input = state.channels[channel];
+    input.filtered = analogRead(input.pin) << (decimationShift + filterShift);
+  }
+  state.converting = 0;
+#ifdef __AVR__
+  selectChannel(state, state.converting);
+  ADCSRB = (ADCSRB & ~(_BV(ADTS2) | _BV(ADTS1) | _BV(ADTS0))) | _BV(ADTS2); // Timer0 overflow
+  ADCSRA |= _BV(ADIF); // no stale completion
+  ADCSRA |= _BV(ADATE) | _BV(ADIE);
+#else
+  state.nextConversion = micros() + analogConversionMicros;
+  SimBoard::active().setAnalogChangeHandler(analogChanged);
+#endif
+}
+
+uint16_t AnalogSampler::value(uint8_t channel) {
+  AnalogSamplerState &state = *sampler;
+#ifndef __AVR__
+  catchUp(state);
+#endif
+  noInterrupts();
+  uint16_t filtered = state.channels[channel].filtered;
+  interrupts();
+  return filtered >> filterShift;
+}
+
+int AnalogSampler::read(uint8_t channel) {
+  return (value(channel) + 2) >> decimationShift;
+}
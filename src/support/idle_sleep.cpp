@@ -0,0 +1,55 @@
+/*
+    idle_sleep.cpp
+    2026-10-17
+
+    Sleeps the CPU between ticks, and counts how long it slept
+    Design notes are in the .h file
+*/
+
+#include "idle_sleep.h"
+
+#include <Arduino.h>
+
+#include "board_local.h"
+
+#ifdef __AVR__
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+#else
+#include "sim_board.h"
+#endif
+
+struct IdleSleepState {
+  unsigned long windowStart = 0;
+  unsigned long asleep = 0;
+};
+
+static BoardLocal<IdleSleepState> counters;
+
+void IdleSleep::sleep(void) {
+  unsigned long start = micros();
+#ifdef __AVR__
+  set_sleep_mode(SLEEP_MODE_IDLE);
+  cli();
+  sleep_enable();
+  sei(); // the instruction after sei always runs, so an interrupt now still wakes sleep_cpu()
+  sleep_cpu();
+  sleep_disable();
+#else
+  SimBoard::active().advanceMicros(idleWakeMicros - start % idleWakeMicros);
+#endif
+  counters->asleep += micros() - start;
+}
+
+unsigned long IdleSleep::asleepMicros(void) {
+  return counters->asleep;
+}
+
+unsigned long IdleSleep::awakeMicros(void) {
+  return (micros() - counters->windowStart) - counters->asleep;
+}
+
+void IdleSleep::resetCounters(void) {
+  counters->windowStart = micros();
+  counters->asleep = 0;
+}
@@ -0,0 +1,246 @@
+/*
+    input_engine.cpp
+    2026-10-17
+
+    Interrupt driven digital inputs: debounced, timestamped on/off and long press events
+    Design notes are in the .h file
+*/
+
+#include "input_engine.h"
+
+#include <Arduino.h>
+
+#include "board_local.h"
+
+#ifdef __AVR__
+#include <avr/interrupt.h>
+#else
+#include "sim_board.h"
+#endif
+
+typedef struct {
+  uint8_t pin;
+#ifdef __AVR__
+  volatile uint8_t *input;
+  uint8_t mask;
+  bool pinChange; // on a PCINT bank; otherwise sampled
+#endif
+  uint8_t onLevel;
+  uint8_t debounceMillis;
+  uint16_t longPressMillis;
+  uint8_t stable; // debounced level
+  uint8_t raw;    // level after the last edge
+  bool held;      // InputHeld already reported for this press
+  bool wakeOnly;  // edges only set the channel's wake bit, and call wake
+  InputWakeHandler wake;
+  void *wakeContext;
+  unsigned long firstEdge; // first edge of the burst leaving the stable level
+  unsigned long lastEdge;
+  unsigned long onSince;
+} InputChannel;
+
+struct InputEngineState {
+  // Channels are only written by attach(), before begin(); after that they belong to the interrupts
+  InputChannel channels[inputMaxChannels];
+  volatile uint8_t channelCount = 0;
+
+  // pushed in interrupt context, popped by read()
+  SpscRing<InputEvent, inputEventQueueSize> events;
+  volatile uint8_t wakes = 0; // one bit per wake channel
+};
+
+static BoardLocal<InputEngineState> engine;
+
+static void push(InputEngineState &state, uint8_t channel, uint8_t type, unsigned long when) {
+  InputEvent event;
+  event.millis = when;
+  event.source = channel;
+  event.payload = type;
+  state.events.push(event);
+}
+
+static void accept(InputEngineState &state, uint8_t channel) {
+  InputChannel &input = state.channels[channel];
+  input.stable = input.raw;
+  bool on = input.stable == input.onLevel;
+  push(state, channel, on ? InputTurnedOn : InputTurnedOff, input.firstEdge);
+  if (on) {
+    input.onSince = input.firstEdge;
+    input.held = false;
+  }
+}
+
+static void edge(InputEngineState &state, uint8_t channel, uint8_t level, unsigned long now) {
+  InputChannel &input = state.channels[channel];
+  if (level == input.raw) {
+    return;
+  }
+  if (input.wakeOnly) {
+    input.raw = level;
+    state.wakes |= 1 << channel;
+    if (input.wake != NULL) {
+      input.wake(input.wakeContext, input.pin, level, now);
+    }
+    return;
+  }
+  // the level being left may have settled long enough to count
+  if (input.raw != input.stable && (now - input.lastEdge) >= input.debounceMillis) {
+    accept(state, channel);
+  }
+  // a burst starts with the first edge after the input has been quiet at its stable level; a
+  //   bounce back through that level is still the same burst
+  if (input.raw == input.stable && (now - input.lastEdge) >= input.debounceMillis) {
+    input.firstEdge = now;
+  }
+  input.raw = level;
+  input.lastEdge = now;
+  if (input.raw != input.stable && input.debounceMillis == 0) {
+    accept(state, channel);
+  }
+}
+
+// accept levels that have settled and report long presses
+static void service(InputEngineState &state, unsigned long now) {
+  for (uint8_t channel = 0; channel < state.channelCount; channel++) {
+    InputChannel &input = state.channels[channel];
+    if (input.wakeOnly) {
+      continue;
+    }
+    if (input.raw != input.stable && (now - input.lastEdge) >= input.debounceMillis) {
+      accept(state, channel);
+    }
+    if (input.longPressMillis != 0 && !input.held && input.stable == input.onLevel &&
+        (now - input.onSince) >= input.longPressMillis) {
+      input.held = true;
+      push(state, channel, InputHeld, input.onSince + input.longPressMillis);
+    }
+  }
+}
+
+#ifdef __AVR__
+
+static void sample(InputEngineState &state, bool pinChangeChannels) {
+  unsigned long now = millis();
+  for (uint8_t channel = 0; channel < state.channelCount; channel++) {
+    InputChannel &input = state.channels[channel];
+    if (input.pinChange == pinChangeChannels) {
+      edge(state, channel, (*input.input & input.mask) ? HIGH : LOW, now);
+    }
+  }
+}
+
+ISR(PCINT0_vect) {
+  sample(*engine, true);
+}
+ISR(PCINT1_vect, ISR_ALIASOF(PCINT0_vect));
+ISR(PCINT2_vect, ISR_ALIASOF(PCINT0_vect));
+
+ISR(TIMER0_COMPA_vect) {
+  sample(*engine, false);
+  service(*engine, millis());
+}
+
+#else
+
+static void pinChanged(uint8_t pin, int level) {
+  InputEngineState &state = *engine;
+  unsigned long now = millis();
+  for (uint8_t channel = 0; channel < state.channelCount; channel++) {
+    if (state.channels[channel].pin == pin) {
+      edge(state, channel, level ? HIGH : LOW, now);
+    }
+  }
+}
+
+#endif
+
+int8_t InputEngine::attach(uint8_t pin, bool highIsOn, uint8_t debounceMillis, uint16_t longPressMillis) {
+  InputEngineState &state = *engine;
+  if (state.channelCount >= inputMaxChannels) {
+    return -1;
+  }
+  InputChannel &input = state.channels[state.channelCount];
+  input.pin = pin;
+#ifdef __AVR__
+  input.input = portInputRegister(digitalPinToPort(pin));
+  input.mask = digitalPinToBitMask(pin);
+  input.pinChange = digitalPinToPCICR(pin) != 0;
+#endif
+  input.onLevel = highIsOn ? HIGH : LOW;
+  input.debounceMillis = debounceMillis;
+  input.longPressMillis = longPressMillis;
+  input.stable = digitalRead(pin) ? HIGH : LOW;
+  input.raw = input.stable;
+  input.held = true; // already on at startup is not a press
+  input.wakeOnly = false;
+  input.wake = NULL;
+  input.firstEdge = millis();
+  input.lastEdge = input.firstEdge;
+  input.onSince = input.firstEdge;
+  return state.channelCount++;
+}
+
+int8_t InputEngine::attachWake(uint8_t pin, InputWakeHandler handler, void *context) {
+  int8_t channel = attach(pin, false, 0, 0);
+  if (channel >= 0) {
+    InputChannel &input = engine->channels[channel];
+    input.wakeOnly = true;
+    input.wake = handler;
+    input.wakeContext = context;
+  }
+  return channel;
+}
+
+void InputEngine::begin(void) {
+  InputEngineState &state = *engine;
+#ifdef __AVR__
+  bool sampling = false;
+  for (uint8_t channel = 0; channel < state.channelCount; channel++) {
+    uint8_t pin = state.channels[channel].pin;
+    if (state.channels[channel].pinChange) {
+      *digitalPinToPCMSK(pin) |= _BV(digitalPinToPCMSKbit(pin));
+      *digitalPinToPCICR(pin) |= _BV(digitalPinToPCICRbit(pin));
+    }
+    else {
+      sampling = true;
+    }
+  }
+  if (sampling) {
+    TIMSK0 |= _BV(OCIE0A);
+  }
+#else
+  SimBoard &board = SimBoard::active();
+  for (uint8_t channel = 0; channel < state.channelCount; channel++) {
+    board.watchPin(state.channels[channel].pin);
+  }
+  board.setPinChangeHandler(pinChanged);
+#endif
+}
+
+bool InputEngine::read(InputEvent &event) {
+  InputEngineState &state = *engine;
+#ifndef __AVR__
+  service(state, millis());
+#endif
+  return state.events.pop(event);
+}
+
+bool InputEngine::isOn(uint8_t channel) {
+  InputChannel &input = engine->channels[channel];
+  return input.stable == input.onLevel;
+}
+
+bool InputEngine::takeWakes(uint8_t mask) {
+  InputEngineState &state = *engine;
+  if ((state.wakes & mask) == 0) {
+    return false;
+  }
+  noInterrupts();
+  state.wakes &= ~mask;
+  interrupts();
+  return true;
+}
+
+unsigned long InputEngine::overflows(void) {
+  return engine->events.overflows();
+}
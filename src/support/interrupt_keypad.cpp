@@ -0,0 +1,116 @@
+/*
+    interrupt_keypad.cpp
+    2026-10-17
+
+    Keypad that sleeps until a key is pressed
+    Design notes are in the .h file
+*/
+
+#include "interrupt_keypad.h"
+
+#include <Arduino.h>
+
+#include "input_engine.h"
+
+InterruptKeypad::InterruptKeypad(char *userKeymap, byte *row, byte *col, byte numRows, byte numCols) :
+    Keypad(userKeymap, row, col, numRows, numCols) {
+  _keymap = userKeymap;
+  _rowPins = row;
+  _columnPins = col;
+  _rows = numRows;
+  _columns = numCols;
+  _interrupts = false;
+  _scanning = false;
+  _rowsDown = 0;
+}
+
+bool InterruptKeypad::useInterrupts(void) {
+  if (_rows > interruptKeypadMaxRows) {
+    return false;
+  }
+  for (byte r = 0; r < _rows; r++) {
+    pin_mode(_rowPins[r], INPUT_PULLUP);
+    _rowEdges[r] = millis() - interruptKeypadDebounceMillis;
+    if (InputEngine::attachWake(_rowPins[r], wake, this) < 0) {
+      return false; // rows already attached just wake nobody
+    }
+  }
+  _interrupts = true;
+  arm();
+  return true;
+}
+
+char InterruptKeypad::getKey(void) {
+  if (!_interrupts) {
+    return Keypad::getKey();
+  }
+  char key;
+  return _keys.pop(key) ? key : NO_KEY;
+}
+
+void InterruptKeypad::wake(void *keypad, uint8_t pin, uint8_t level, unsigned long now) {
+  ((InterruptKeypad *)keypad)->rowChanged(pin, level, now);
+}
+
+// interrupt context
+void InterruptKeypad::rowChanged(uint8_t pin, uint8_t level, unsigned long now) {
+  if (_scanning) {
+    return;
+  }
+  uint8_t r = 0;
+  while (r < _rows && _rowPins[r] != pin) {
+    r++;
+  }
+  if (r == _rows) {
+    return;
+  }
+  uint8_t bit = 1 << r;
+  bool quiet = (now - _rowEdges[r]) >= interruptKeypadDebounceMillis;
+
+  if (level == LOW && !(_rowsDown & bit) && quiet) {
+    // a press; if the contact bounced open before the scan, the next fall tries again
+    char key = scanRow(r);
+    if (key != NO_KEY) {
+      _keys.push(key);
+      _rowsDown |= bit;
+      _rowEdges[r] = now;
+    }
+  }
+  else if (level == HIGH && (_rowsDown & bit)) {
+    _rowsDown &= ~bit;
+    _rowEdges[r] = now;
+  }
+  else if (!quiet) {
+    _rowEdges[r] = now; // still bouncing: wait for it to settle
+  }
+}
+
+// the key down in row, found the way scanKeys() does it: one column at a time pulled low
+char InterruptKeypad::scanRow(uint8_t row) {
+  _scanning = true;
+  for (byte c = 0; c < _columns; c++) {
+    pin_write(_columnPins[c], HIGH);
+    pin_mode(_columnPins[c], INPUT);
+  }
+  char key = NO_KEY;
+  for (byte c = 0; c < _columns && key == NO_KEY; c++) {
+    pin_mode(_columnPins[c], OUTPUT);
+    pin_write(_columnPins[c], LOW);
+    if (pin_read(_rowPins[row]) == LOW) {
+      key = _keymap[row * _columns + c];
+    }
+    pin_write(_columnPins[c], HIGH);
+    pin_mode(_columnPins[c], INPUT);
+  }
+  arm();
+  _scanning = false;
+  return key;
+}
+
+// drive every column low so a key press pulls its row low
+void InterruptKeypad::arm(void) {
+  for (byte c = 0; c < _columns; c++) {
+    pin_mode(_columnPins[c], OUTPUT);
+    pin_write(_columnPins[c], LOW);
+  }
+}
@@ -0,0 +1,110 @@
+/*
+    lcd_framebuffer.cpp
+    2026-10-17
+
+    Shadow frame buffer in front of a LiquidCrystal_I2C character display
+    Design notes are in the .h file
+*/
+
+#include "lcd_framebuffer.h"
+#include <Arduino.h>
+
+// Unchanged cells between two changed runs that are cheaper to rewrite than to skip with setCursor()
+const uint8_t bridgeableGap = 1;
+
+LCDFrameBuffer::LCDFrameBuffer(LiquidCrystal_I2C &panel) :
+    _panel(panel) {
+  clear();
+  invalidate();
+}
+
+void LCDFrameBuffer::setCursor(uint8_t column, uint8_t row) {
+  _column = column;
+  _row = row;
+}
+
+size_t LCDFrameBuffer::write(uint8_t value) {
+  // like the panel, characters past the end of a row are accepted but never seen
+  if (_row < lcdFrameRows && _column < lcdFrameColumns) {
+    _frame[_row][_column] = value;
+  }
+  _column++;
+  return 1;
+}
+
+size_t LCDFrameBuffer::write(const uint8_t *buffer, size_t size) {
+  // print() hands over whole strings; copy the part that lands on the row in one go
+  if (_row < lcdFrameRows && _column < lcdFrameColumns) {
+    size_t room = lcdFrameColumns - _column;
+    memcpy(&_frame[_row][_column], buffer, size < room ? size : room);
+  }
+  _column += size;
+  return size;
+}
+
+void LCDFrameBuffer::clear(void) {
+  memset(_frame, ' ', sizeof(_frame));
+  _column = 0;
+  _row = 0;
+}
+
+void LCDFrameBuffer::panelCleared(void) {
+  memset(_shown, ' ', sizeof(_shown));
+  memset(_shownValid, true, sizeof(_shownValid));
+  _panelColumn = 0;
+  _panelRow = 0;
+}
+
+void LCDFrameBuffer::invalidate(void) {
+  memset(_shownValid, false, sizeof(_shownValid));
+  _panelColumn = lcdFrameColumns;
+  _panelRow = 0;
+}
+
+uint8_t LCDFrameBuffer::update(void) {
+  if (!_panel.ready()) {
+    return 0;
+  }
+  uint8_t sent = 0;
+
+  for (uint8_t row = 0; row < lcdFrameRows; row++) {
+    // most ticks change nothing: settle a whole row with one compare
+    if (memcmp(_shown[row], _frame[row], lcdFrameColumns) == 0 && !memchr(_shownValid[row], false, lcdFrameColumns)) {
+      continue;
+    }
+    uint8_t column = 0;
+    while (column < lcdFrameColumns) {
+      if (_shownValid[row][column] && _shown[row][column] == _frame[row][column]) {
+        column++;
+        continue;
+      }
+
+      // extend the run over changed cells and any short gaps between them
+      uint8_t end = column + 1;
+      uint8_t lastChanged = column;
+      while (end < lcdFrameColumns && end - lastChanged <= bridgeableGap + 1) {
+        if (!_shownValid[row][end] || _shown[row][end] != _frame[row][end]) {
+          lastChanged = end;
+        }
+        end++;
+      }
+      end = lastChanged + 1;
+
+      if (_panelRow != row || _panelColumn != column) {
+        _panel.setCursor(column, row);
+      }
+      // one bulk write, packed into as few I2C transactions as the panel can manage
+      _panel.write((const uint8_t *)&_frame[row][column], end - column);
+      for (uint8_t i = column; i < end; i++) {
+        _shown[row][i] = _frame[row][i];
+        _shownValid[row][i] = true;
+      }
+      sent += end - column;
+
+      _panelRow = row;
+      _panelColumn = end;
+      column = end;
+    }
+  }
+  return sent;
+}
@@ -7,20 +7,35 @@
 
 #include <Arduino.h>
 #include "passive_buzzer.h"
+#include "telemetry.h"
+#include "tone_sequencer.h"
 
-const int oneSecond = 1000;
+// Alarm patterns: frequency (Hz, 0 = rest), duration (ms)
+const ToneStep alertSteps[] PROGMEM = {{880, 250}, {440, 250}}; // two tone siren
+const ToneStep criticalSteps[] PROGMEM = {                         // SOS
+    {880, 150}, {0, 150}, {880, 150}, {0, 150}, {880, 150}, {0, 450},
+    {880, 450}, {0, 150}, {880, 450}, {0, 150}, {880, 450}, {0, 450},
+    {880, 150}, {0, 150}, {880, 150}, {0, 150}, {880, 150}, {0, 1050}};
+const ToneStep lowSteps[] PROGMEM = {{220, 150}, {0, 100}, {220, 150}}; // double chirp
+
+#define stepsIn(steps) (sizeof(steps) / sizeof(steps[0]))
+
+// indexed by AlarmSignals
+const TonePattern alarmPatterns[] PROGMEM = {
+    {NULL, 0, 0},
+    {alertSteps, stepsIn(alertSteps), 8},       // 4 seconds
+    {criticalSteps, stepsIn(criticalSteps), 2}, // 11.4 seconds
+    {lowSteps, stepsIn(lowSteps), 1}};
+const uint8_t alarmPriorities[] PROGMEM = {0, 3, 2, 1};
 
 Buzzer::Buzzer(uint8_t pin) {
     _pin = pin;
-    pinMode(_pin, OUTPUT);
+    ToneSequencer::begin(_pin);
     _alarm = noAlarm;
     _previousAlarm = noAlarm;
 }
 
 void Buzzer::alarm(AlarmSignals signal) {
-    static int signalFreq[] = {0, 440, 880, 220}; // TBD: Fix magic number
-    static int signalDuration = oneSecond;
-
     // don't repeat the same alarm
     if (signal != _alarm) {
         switch (signal) {
@@ -34,12 +49,12 @@ void Buzzer::alarm(AlarmSignals signal) {
                 if (_alarm != _previousAlarm) {
                     _previousAlarm = _alarm;
 
-                    play(signalFreq[signal], signalDuration);
+                    Telemetry::event(TelemetryAlarm, signal);
+                    ToneSequencer::play(&alarmPatterns[signal], pgm_read_byte(&alarmPriorities[signal]));
                 }
                 break;
             default:
-                Serial.print("unknown alarm signal: ");
-                Serial.println(signal);
+                Telemetry::event(TelemetryUnknownAlarmSignal, signal);
                 alarmOff();
                 break;
         }
@@ -47,11 +62,16 @@ void Buzzer::alarm(AlarmSignals signal) {
 }
 
 void Buzzer::alarmOff() {
-    noTone(_pin);
+    ToneSequencer::stop();
     _previousAlarm = _alarm;
     _alarm = noAlarm;
 }
 
+AlarmSignals Buzzer::signal(void) {
+    return _alarm;
+}
+
 void Buzzer::play(int frequency, unsigned long duration) {
+    ToneSequencer::stop();
     tone(_pin, frequency, duration);
 }
@@ -9,18 +9,32 @@
 #include "photoresistor.h"
 #include <Arduino.h>
 
+#include "analog_sampler.h"
+
 const int minPoint = 200;
 const int maxPoint = 1000;
 
 PhotoResistor::PhotoResistor(uint8_t pin) {
   _pin = pin;
-  _value = 0.0;
+  _channel = -1;
+  _value = 0;
+}
+
+bool PhotoResistor::useInterrupts(void) {
+  _channel = AnalogSampler::attach(_pin);
+  return _channel >= 0;
 }
 
-double PhotoResistor::value(void) {
-  int lightLevel = analogRead(_pin);
-  lightLevel = map(lightLevel, minPoint, maxPoint, 0, 255); // Constrain to single byte
+FixedPercent PhotoResistor::value(void) {
+  long lightLevel;
+  if (_channel >= 0) {
+    // the sampler's values have two more bits
+    lightLevel = map(AnalogSampler::value(_channel), minPoint * 4L, maxPoint * 4L, 0, 255); // Constrain to single byte
+  }
+  else {
+    lightLevel = map(analogRead(_pin), minPoint, maxPoint, 0, 255); // Constrain to single byte
+  }
   lightLevel = constrain(lightLevel, 0, 255);
-  _value = ((double)lightLevel) / 2.55; // scale to 0.0 to 100.0
+  _value = lightLevel * 100; // scale to 0.0 to 100.0, exactly lightLevel / 2.55 percent
   return _value;
 }
\ No newline at end of file
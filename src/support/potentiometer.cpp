@@ -9,14 +9,22 @@
 #include <Arduino.h>
 #include <math.h>
 
+#include "analog_sampler.h"
+
 Potentiometer::Potentiometer(uint8_t pin) {
   _pin = pin;
+  _channel = -1;
   _previousValue = 0;
   _currentValue = 0;
 }
 
+bool Potentiometer::useInterrupts(void) {
+  _channel = AnalogSampler::attach(_pin);
+  return _channel >= 0;
+}
+
 int Potentiometer::read(void) {
-  _currentValue = analogRead(_pin);
+  _currentValue = _channel >= 0 ? AnalogSampler::read(_channel) : analogRead(_pin);
   return _currentValue;
 }
 
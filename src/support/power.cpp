@@ -15,61 +15,79 @@
 #include <Arduino.h>
 #include <math.h>
 
-// HouseBattery Storage
-const double maximumBatteryPower = 100.0;
-const double chargingThreshold = 90.0;
-const double prettyFullThreshold = 80.0;
-const double lowThreshold = 25.0;
-const double criticalThreshold = 10.0;
+// C++11, the AVR build's, wants storage for a constexpr member that min() odr-uses
+constexpr FixedPercent MegaPanel::maximumBatteryPower;
 
-HouseBattery::HouseBattery(void) {
-  _battery = 0.0;
+template <class Config> BasicHouseBattery<Config>::BasicHouseBattery(void) {
+  _battery = 0;
   _charging = false;
 }
 
-double HouseBattery::batteryLevel(void) {
+template <class Config> FixedPercent BasicHouseBattery<Config>::batteryLevel(void) {
   return _battery;
 }
 
-HouseBatteryPowerLevel HouseBattery::powerLevel(void) {
-  if (_battery < criticalThreshold) {
+template <class Config> HouseBatteryPowerLevel BasicHouseBattery<Config>::powerLevel(void) {
+  if (_battery < Config::criticalThreshold) {
     return PowerCritical;
   }
-  else if (_battery < lowThreshold) {
+  else if (_battery < Config::lowThreshold) {
     return PowerLow;
   }
-  else if (_battery < prettyFullThreshold) {
+  else if (_battery < Config::prettyFullThreshold) {
     return PowerMiddle;
   }
-  else if (_battery < chargingThreshold) {
+  else if (_battery < Config::chargingThreshold) {
     return PowerNearFull;
   }
   else {
     return PowerFull;
   }
 }
-bool HouseBattery::isCharging(void) {
+template <class Config> bool BasicHouseBattery<Config>::isCharging(void) {
   return _charging;
 }
 
-void HouseBattery::chargeBattery(double solarPower) {
+template <class Config> void BasicHouseBattery<Config>::chargeBattery(FixedPercent solarPower) {
   if (!_charging) {
-    if (_battery < chargingThreshold) {
+    if (_battery < Config::chargingThreshold) {
       _charging = true;
     }
   }
 
-  double solar = solarPower / 50;
+  FixedPercent solar = solarPower / Config::solarChargeDivisor;
   if (_charging) {
-    _battery += solar;
-    _battery = min(_battery, maximumBatteryPower);
-    if (_battery == maximumBatteryPower) {
+    _battery = min(_battery + solar, Config::maximumBatteryPower);
+    if (_battery == Config::maximumBatteryPower) {
       _charging = false;
     }
   }
 }
 
-void HouseBattery::usePower(double powerUsed) {
-  _battery -= powerUsed;
-  _battery = max(_battery, 0.0);
+template <class Config> void BasicHouseBattery<Config>::restore(FixedPercent battery, bool charging) {
+  _battery = min(battery, Config::maximumBatteryPower);
+  _charging = charging;
 }
+
+template <class Config> void BasicHouseBattery<Config>::usePower(FixedPercent powerUsed) {
+  _battery = powerUsed < _battery ? _battery - powerUsed : 0;
+}
+
+template <class Config> void BasicHouseBattery<Config>::receivePower(FixedPercent powerReceived) {
+  FixedPercent room = Config::maximumBatteryPower - min(_battery, Config::maximumBatteryPower);
+  _battery += min(powerReceived, room);
+}
+
+template class BasicHouseBattery<MegaPanel>;
+
+#ifndef __AVR__
+thread_local FixedPercent TunablePanel::chargingThreshold = MegaPanel::chargingThreshold;
+thread_local FixedPercent TunablePanel::prettyFullThreshold = MegaPanel::prettyFullThreshold;
+thread_local FixedPercent TunablePanel::lowThreshold = MegaPanel::lowThreshold;
+thread_local FixedPercent TunablePanel::criticalThreshold = MegaPanel::criticalThreshold;
+thread_local uint8_t TunablePanel::solarChargeDivisor = MegaPanel::solarChargeDivisor;
+thread_local FixedPercent TunablePanel::interiorLightsPowerUsage = MegaPanel::interiorLightsPowerUsage;
+thread_local FixedPercent TunablePanel::exteriorLightsPowerUsage = MegaPanel::exteriorLightsPowerUsage;
+
+template class BasicHouseBattery<TunablePanel>;
+#endif
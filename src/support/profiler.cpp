@@ -0,0 +1,145 @@
+/*
+    profiler.cpp
+    2026-10-17
+
+    Loop timing instrumentation
+    Design notes are in the .h file
+*/
+
+#ifdef AKIT_PROFILE
+
+#include "profiler.h"
+#include <Arduino.h>
+
+#include "idle_sleep.h"
+#include "telemetry.h"
+
+typedef struct {
+  unsigned long count;
+  unsigned long total;
+  unsigned long maximum;
+  uint16_t histogram[profileBuckets];
+} ProfileSamples;
+
+static ProfileSamples samples[profilePointCount];
+
+// the closed window, while its report goes out
+typedef struct {
+  ProfileSamples samples[profilePointCount];
+  uint16_t tickCount;
+  unsigned long awake;
+  unsigned long asleep;
+  bool pending;
+  bool dutyCycleSent;
+  uint8_t point; // the next to send
+  int8_t bucket; // the next of its buckets to send; -1 for its TelemetryProfileRecord
+} ProfileReport;
+
+static ProfileReport report;
+
+static uint8_t bucketFor(unsigned long micros) {
+  uint8_t bucket = 0;
+  while (micros != 0 && bucket < profileBuckets - 1) {
+    micros >>= 1;
+    bucket++;
+  }
+  return bucket;
+}
+
+void Profiler::record(ProfilePoint point, unsigned long micros) {
+  ProfileSamples &s = samples[point];
+  s.count++;
+  s.total += micros;
+  if (micros > s.maximum) {
+    s.maximum = micros;
+  }
+  uint16_t &bucket = s.histogram[bucketFor(micros)];
+  if (bucket != 0xFFFF) {
+    bucket++;
+  }
+}
+
+void Profiler::recordTick(unsigned long tickMicros, unsigned long periodMicros) {
+  record(ProfileTick, tickMicros);
+  record(ProfileSlack, tickMicros < periodMicros ? periodMicros - tickMicros : 0);
+}
+
+// buckets up to the last with any samples
+static uint8_t usedBuckets(const ProfileSamples &s) {
+  uint8_t used = profileBuckets;
+  while (used > 1 && s.histogram[used - 1] == 0) {
+    used--;
+  }
+  return used;
+}
+
+void Profiler::closeWindow(TickCount tickCount) {
+  memcpy(report.samples, samples, sizeof(samples));
+  report.tickCount = tickCount;
+  report.awake = IdleSleep::awakeMicros();
+  report.asleep = IdleSleep::asleepMicros();
+  report.pending = true;
+  report.dutyCycleSent = false;
+  report.point = 0;
+  report.bucket = -1;
+
+  memset(samples, 0, sizeof(samples));
+  IdleSleep::resetCounters();
+}
+
+void Profiler::sendReport(void) {
+  if (!report.pending) {
+    return;
+  }
+  if (!report.dutyCycleSent) {
+    TelemetryDutyCycleRecord record;
+    record.type = TelemetryDutyCycle;
+    record.tickCount = report.tickCount;
+    record.awake = report.awake;
+    record.asleep = report.asleep;
+    if (!Telemetry::background(&record, sizeof(record))) {
+      return;
+    }
+    report.dutyCycleSent = true;
+  }
+
+  while (report.point < profilePointCount) {
+    const ProfileSamples &s = report.samples[report.point];
+    uint8_t used = usedBuckets(s);
+    if (s.count == 0 || report.bucket >= used) {
+      report.point++;
+      report.bucket = -1;
+      continue;
+    }
+
+    if (report.bucket < 0) {
+      TelemetryProfileRecord record;
+      record.type = TelemetryProfile;
+      record.point = report.point;
+      record.count = s.count < 0xFFFF ? s.count : 0xFFFF;
+      record.total = s.total;
+      record.maximum = s.maximum;
+      if (!Telemetry::background(&record, sizeof(record))) {
+        return;
+      }
+      report.bucket = 0;
+    }
+    else {
+      TelemetryHistogramRecord record;
+      record.type = TelemetryHistogram;
+      record.point = report.point;
+      record.first = report.bucket;
+      for (uint8_t i = 0; i < telemetryHistogramBuckets; i++) {
+        uint8_t bucket = report.bucket + i;
+        record.buckets[i] = bucket < used ? s.histogram[bucket] : 0;
+      }
+      if (!Telemetry::background(&record, sizeof(record))) {
+        return;
+      }
+      report.bucket += telemetryHistogramBuckets;
+    }
+  }
+  report.pending = false;
+}
+
+#endif
@@ -0,0 +1,151 @@
+/*
+    state_journal.cpp
+    2026-10-17
+
+    Keeps the dwelling's state in EEPROM across resets and brownouts
+    Design notes are in the .h file
+*/
+
+#include "state_journal.h"
+
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <string.h>
+
+#include "board_local.h"
+#include "crc8.h"
+
+#ifdef __AVR__
+#include <avr/eeprom.h>
+#else
+#include "sim_board.h"
+#endif
+
+const uint8_t journalVersion = 1; // an erased cell reads 0xFF
+const uint8_t journalCharging = 0x01;
+
+typedef struct __attribute__((packed)) {
+  uint16_t sequence;
+  FixedPercent battery;
+  uint8_t unlockFailures;
+  uint8_t flags;
+  uint8_t version;
+  uint8_t crc; // of the bytes before it; written last
+} JournalRecord;
+
+struct StateJournalState {
+  PersistentState wanted;
+  bool wantedNow = false;
+  bool haveWanted = false;
+  PersistentState written; // in the last complete record
+  bool haveWritten = false;
+  unsigned long writtenMillis = 0;
+
+  uint8_t nextSlot = 0;
+  uint16_t nextSequence = 0;
+  JournalRecord writing;
+  uint8_t writingByte = sizeof(JournalRecord); // none in progress
+  unsigned long recordCount = 0;
+};
+
+static BoardLocal<StateJournalState> journalState;
+
+static bool eepromReady(void) {
+#ifdef __AVR__
+  return eeprom_is_ready();
+#else
+  return SimBoard::active().eepromReady();
+#endif
+}
+
+static uint16_t slotAddress(uint8_t slot) {
+  return journalAddress + slot * sizeof(JournalRecord);
+}
+
+static bool sameState(const PersistentState &a, const PersistentState &b) {
+  return a.battery == b.battery && a.charging == b.charging && a.unlockFailures == b.unlockFailures;
+}
+
+bool StateJournal::restore(PersistentState &state) {
+  bool found = false;
+  JournalRecord newest;
+  uint8_t newestSlot = 0;
+  for (uint8_t slot = 0; slot < journalSlots; slot++) {
+    JournalRecord record;
+    uint8_t *bytes = (uint8_t *)&record;
+    for (uint8_t i = 0; i < sizeof(record); i++) {
+      bytes[i] = EEPROM.read(slotAddress(slot) + i);
+    }
+    if (record.version != journalVersion || crc8(bytes, sizeof(record) - 1) != record.crc) {
+      continue;
+    }
+    if (!found || (int16_t)(record.sequence - newest.sequence) > 0) {
+      newest = record;
+      newestSlot = slot;
+      found = true;
+    }
+  }
+  if (!found) {
+    return false;
+  }
+
+  state.battery = newest.battery;
+  state.charging = (newest.flags & journalCharging) != 0;
+  state.unlockFailures = newest.unlockFailures;
+  StateJournalState &journal = *journalState;
+  journal.written = state;
+  journal.haveWritten = true;
+  journal.writtenMillis = millis();
+  journal.nextSlot = (newestSlot + 1) % journalSlots;
+  journal.nextSequence = newest.sequence + 1;
+  return true;
+}
+
+void StateJournal::save(const PersistentState &state, bool now) {
+  StateJournalState &journal = *journalState;
+  journal.wanted = state;
+  journal.haveWanted = true;
+  journal.wantedNow = journal.wantedNow || now;
+}
+
+static void startRecord(StateJournalState &journal) {
+  journal.writing.sequence = journal.nextSequence++;
+  journal.writing.battery = journal.wanted.battery;
+  journal.writing.unlockFailures = journal.wanted.unlockFailures;
+  journal.writing.flags = journal.wanted.charging ? journalCharging : 0;
+  journal.writing.version = journalVersion;
+  journal.writing.crc = crc8((const uint8_t *)&journal.writing, sizeof(journal.writing) - 1);
+  journal.writingByte = 0;
+  journal.written = journal.wanted;
+  journal.wantedNow = false;
+}
+
+void StateJournal::service(void) {
+  StateJournalState &journal = *journalState;
+  if (journal.writingByte == sizeof(JournalRecord)) {
+    if (!journal.haveWanted || (journal.haveWritten && sameState(journal.wanted, journal.written))) {
+      journal.wantedNow = false;
+      return;
+    }
+    if (!journal.wantedNow && journal.haveWritten && millis() - journal.writtenMillis < journalIntervalMillis) {
+      return;
+    }
+    startRecord(journal);
+  }
+
+  const uint8_t *bytes = (const uint8_t *)&journal.writing;
+  while (journal.writingByte < sizeof(JournalRecord) && eepromReady()) {
+    EEPROM.update(slotAddress(journal.nextSlot) + journal.writingByte, bytes[journal.writingByte]);
+    journal.writingByte++;
+  }
+  if (journal.writingByte == sizeof(JournalRecord)) {
+    journal.haveWritten = true;
+    journal.writtenMillis = millis();
+    journal.nextSlot = (journal.nextSlot + 1) % journalSlots;
+    journal.recordCount++;
+  }
+}
+
+unsigned long StateJournal::records(void) {
+  return journalState->recordCount;
+}
@@ -0,0 +1,170 @@
+/*
+    telemetry.cpp
+    2026-10-17
+
+    Compact binary telemetry over Serial
+    Design notes are in the .h file
+*/
+
+#include "telemetry.h"
+
+#include <Arduino.h>
+#include <string.h>
+
+#include "board_local.h"
+#include "crc8.h"
+#include "spsc_ring.h"
+
+struct TelemetryState {
+  // the main loop both fills and drains it, so the ring's ordering is not needed, only its shape
+  SpscRing<uint8_t, telemetryBufferSize> buffer;
+  unsigned long droppedFrames = 0;
+  int16_t unreported = 0; // dropped since the last TelemetryDropped went out
+};
+
+static BoardLocal<TelemetryState> telemetry;
+
+// COBS: each zero becomes the distance to the next one, with a leading distance standing in for
+//   a zero before the data; records are far shorter than 254 bytes, so no other code is needed.
+//   frame needs length + 2 bytes; returns the bytes used, the terminating zero included
+static uint8_t encodeFrame(const uint8_t *data, uint8_t length, uint8_t *frame) {
+  uint8_t codeAt = 0;
+  uint8_t next = 1;
+  for (uint8_t i = 0; i < length; i++) {
+    if (data[i] == 0) {
+      frame[codeAt] = next - codeAt;
+      codeAt = next++;
+    }
+    else {
+      frame[next++] = data[i];
+    }
+  }
+  frame[codeAt] = next - codeAt;
+  frame[next++] = 0;
+  return next;
+}
+
+// the decoded bytes go to record, but for the last, the CRC, which is held back in case the record
+//   fills all maxLength bytes
+static bool putDecoded(uint8_t data, uint8_t *record, uint8_t maxLength, uint8_t &decoded, uint8_t &last) {
+  if (decoded > maxLength) {
+    return false;
+  }
+  if (decoded > 0) {
+    record[decoded - 1] = last;
+  }
+  last = data;
+  decoded++;
+  return true;
+}
+
+uint8_t Telemetry::decodeFrame(const uint8_t *frame, uint8_t length, uint8_t *record, uint8_t maxLength) {
+  uint8_t decoded = 0;
+  uint8_t last = 0;
+  uint8_t i = 0;
+  while (i < length) {
+    uint8_t code = frame[i++];
+    if (code == 0 || i + code - 1 > length) {
+      return 0;
+    }
+    for (uint8_t j = 1; j < code; j++) {
+      if (!putDecoded(frame[i++], record, maxLength, decoded, last)) {
+        return 0;
+      }
+    }
+    if (i < length) { // a zero, except after the last block
+      if (!putDecoded(0, record, maxLength, decoded, last)) {
+        return 0;
+      }
+    }
+  }
+  // the last byte is the CRC of the rest
+  if (decoded < 2 || crc8(record, decoded - 1) != last) {
+    return 0;
+  }
+  return decoded - 1;
+}
+
+static void enqueue(TelemetryState &state, const void *record, uint8_t length) {
+  uint8_t data[telemetryMaxRecord + 1];
+  memcpy(data, record, length);
+  data[length] = crc8(data, length);
+  uint8_t frame[telemetryMaxFrame];
+  state.buffer.push(frame, encodeFrame(data, length + 1, frame));
+}
+
+static void makeEvent(TelemetryEventRecord &record, TelemetryEventCode code, int16_t value) {
+  record.type = TelemetryEvent;
+  record.millis = millis();
+  record.code = code;
+  record.value = value;
+}
+
+// the whole frame or none of it; a report of earlier drops goes first, so the gap shows where it was
+static bool send(const void *record, uint8_t length) {
+  TelemetryState &state = *telemetry;
+  uint8_t needed = length + 3;
+  if (state.unreported != 0) {
+    needed += sizeof(TelemetryEventRecord) + 3;
+  }
+  if (telemetryBufferSize - state.buffer.count() < needed) {
+    state.droppedFrames++;
+    if (state.unreported != 0x7FFF) {
+      state.unreported++;
+    }
+    return false;
+  }
+  if (state.unreported != 0) {
+    TelemetryEventRecord report;
+    makeEvent(report, TelemetryDropped, state.unreported);
+    enqueue(state, &report, sizeof(report));
+    state.unreported = 0;
+  }
+  enqueue(state, record, length);
+  return true;
+}
+
+bool Telemetry::background(const void *record, uint8_t length) {
+  TelemetryState &state = *telemetry;
+  const uint8_t reserved = sizeof(TelemetryTickRecord) + 3 + sizeof(TelemetryEventRecord) + 3;
+  // a drop report waits for the next tick or event, so the gap shows where it was
+  if (state.unreported != 0 || telemetryBufferSize - state.buffer.count() < length + 3 + reserved) {
+    return false;
+  }
+  enqueue(state, record, length);
+  return true;
+}
+
+bool Telemetry::tick(TelemetryTickRecord &record) {
+  record.type = TelemetryTick;
+  return send(&record, sizeof(record));
+}
+
+bool Telemetry::event(TelemetryEventCode code, int16_t value) {
+  TelemetryEventRecord record;
+  makeEvent(record, code, value);
+  return send(&record, sizeof(record));
+}
+
+// in chunks, which the core writes a byte at a time anyway and the host's Serial takes whole
+void Telemetry::pump(void) {
+  TelemetryState &state = *telemetry;
+  int room = Serial.availableForWrite();
+  uint8_t chunk[telemetryMaxFrame];
+  while (room > 0) {
+    uint8_t length = state.buffer.pop(chunk, room < (int)sizeof(chunk) ? room : sizeof(chunk));
+    if (length == 0) {
+      break;
+    }
+    Serial.write(chunk, length);
+    room -= length;
+  }
+}
+
+uint8_t Telemetry::pending(void) {
+  return telemetry->buffer.count();
+}
+
+unsigned long Telemetry::dropped(void) {
+  return telemetry->droppedFrames;
+}
@@ -0,0 +1,149 @@
+/*
+    tone_sequencer.cpp
+    2026-10-17
+
+    Plays tone patterns on the buzzer from a timer interrupt
+    Design notes are in the .h file
+*/
+
+#include "tone_sequencer.h"
+
+#include <Arduino.h>
+
+#include "board_local.h"
+
+#ifdef __AVR__
+#include <avr/interrupt.h>
+#else
+#include "sim_board.h"
+#endif
+
+// written by play() and stop() with interrupts off, otherwise only by the interrupt
+struct ToneSequencerState {
+  uint8_t buzzerPin = 0;
+  const ToneStep *steps = NULL;
+  uint8_t stepCount = 0;
+  uint8_t repeats = 0;
+  volatile uint8_t repeatsLeft = 0;
+  volatile uint8_t stepIndex = 0;
+  volatile long remainingMicros = 0;
+  volatile bool playing = false;
+  volatile uint8_t playingPriority = 0;
+};
+
+static BoardLocal<ToneSequencerState> sequencer;
+
+static void sequencerTick(void);
+
+static void enableTimer(bool enable) {
+#ifdef __AVR__
+  if (enable) {
+    TIFR0 = _BV(OCF0B); // no stale match
+    TIMSK0 |= _BV(OCIE0B);
+  }
+  else {
+    TIMSK0 &= ~_BV(OCIE0B);
+  }
+#else
+  if (enable) {
+    SimBoard::active().attachTimer(toneSequencerTickMicros, sequencerTick);
+  }
+  else {
+    SimBoard::active().detachTimer(sequencerTick);
+  }
+#endif
+}
+
+static void startStep(ToneSequencerState &state) {
+  uint16_t frequency = pgm_read_word(&state.steps[state.stepIndex].frequency);
+  uint16_t duration = pgm_read_word(&state.steps[state.stepIndex].durationMillis);
+  if (frequency != 0) {
+    tone(state.buzzerPin, frequency);
+  }
+  else {
+    noTone(state.buzzerPin);
+  }
+  state.remainingMicros += duration * 1000L; // added, so rounding to whole ticks never accumulates
+}
+
+static void finish(ToneSequencerState &state) {
+  noTone(state.buzzerPin);
+  state.playing = false;
+  enableTimer(false);
+}
+
+static void sequencerTick(void) {
+  ToneSequencerState &state = *sequencer;
+  if (!state.playing) {
+    return;
+  }
+  state.remainingMicros -= toneSequencerTickMicros;
+  if (state.remainingMicros > 0) {
+    return;
+  }
+  state.stepIndex++;
+  if (state.stepIndex >= state.stepCount) {
+    state.stepIndex = 0;
+    if (state.repeats != 0 && --state.repeatsLeft == 0) {
+      finish(state);
+      return;
+    }
+  }
+  startStep(state);
+}
+
+#ifdef __AVR__
+ISR(TIMER0_COMPB_vect) {
+  sequencerTick();
+}
+#endif
+
+void ToneSequencer::begin(uint8_t pin) {
+  sequencer->buzzerPin = pin;
+  pinMode(pin, OUTPUT);
+}
+
+bool ToneSequencer::play(const TonePattern *pattern, uint8_t priority) {
+  TonePattern copy;
+  memcpy_P(&copy, pattern, sizeof(copy));
+  if (copy.stepCount == 0) {
+    return false;
+  }
+
+  ToneSequencerState &state = *sequencer;
+  noInterrupts();
+  if (state.playing && priority < state.playingPriority) {
+    interrupts();
+    return false;
+  }
+  state.steps = copy.steps;
+  state.stepCount = copy.stepCount;
+  state.repeats = copy.repeats;
+  state.repeatsLeft = copy.repeats;
+  state.stepIndex = 0;
+  state.remainingMicros = 0;
+  state.playingPriority = priority;
+  startStep(state);
+  state.playing = true;
+  enableTimer(true);
+  interrupts();
+  return true;
+}
+
+void ToneSequencer::stop(void) {
+  ToneSequencerState &state = *sequencer;
+  noInterrupts();
+  if (state.playing) {
+    finish(state);
+  }
+  interrupts();
+}
+
+bool ToneSequencer::isPlaying(void) {
+  return sequencer->playing;
+}
+
+uint8_t ToneSequencer::priority(void) {
+  ToneSequencerState &state = *sequencer;
+  return state.playing ? state.playingPriority : 0;
+}
@@ -0,0 +1,151 @@
+/*
+    test_main.cpp (test_analog_sampler)
+    2026-10-17
+
+    AnalogSampler on the simulated ADC, fed known readings between the conversions it makes once
+        per 1.024ms, round robin over the attached channels:
+        begin() seeds each channel with one reading
+        a sample is 16 conversions, and nothing moves until the 16th; readings that vary within
+            a block are averaged, so noise about a steady level leaves the value where it was
+        each sample moves the value a quarter of the way to it: a step settles as 1 - (3/4)^n,
+            about two thirds in four samples, and exactly on the new level in the end
+        channels are converted in turn and do not disturb each other
+
+    pio test -e native -f test_analog_sampler
+*/
+
+#include <Arduino.h>
+#include <math.h>
+#include <unity.h>
+
+#include "analog_sampler.h"
+#include "sim_board.h"
+
+const uint8_t solar = A0;
+const uint8_t knob = A0 + 1;
+
+static SimBoard *board;
+static SimBoard::Scope *scope;
+static unsigned long begun;
+
+// when conversion number conversion (from 1) is made
+static unsigned long conversionAt(unsigned long conversion) {
+  return begun + conversion * analogConversionMicros;
+}
+
+static void runUntil(unsigned long micros) {
+  board->advanceMicros(micros - board->micros());
+}
+
+static void begin(void) {
+  AnalogSampler::begin();
+  begun = board->micros();
+}
+
+void setUp(void) {
+  board = new SimBoard();
+  scope = new SimBoard::Scope(*board);
+  board->advanceMicros(777);
+}
+
+void tearDown(void) {
+  delete scope;
+  delete board;
+}
+
+void test_begin_seeds_each_channel(void) {
+  board->setAnalogInput(solar, 500);
+  board->setAnalogInput(knob, 1023);
+  TEST_ASSERT_EQUAL(0, AnalogSampler::attach(solar));
+  TEST_ASSERT_EQUAL(1, AnalogSampler::attach(knob));
+  begin();
+  TEST_ASSERT_EQUAL(2000, AnalogSampler::value(0));
+  TEST_ASSERT_EQUAL(500, AnalogSampler::read(0));
+  TEST_ASSERT_EQUAL(analogValueMax, AnalogSampler::value(1));
+  TEST_ASSERT_EQUAL(1023, AnalogSampler::read(1));
+}
+
+void test_a_sample_is_sixteen_conversions(void) {
+  board->setAnalogInput(solar, 0);
+  AnalogSampler::attach(solar);
+  begin();
+
+  // a ramp, one reading per conversion: 0, 64, ... 960 averages 480, 1920 in 12 bits
+  for (unsigned long conversion = 1; conversion <= analogOversample; conversion++) {
+    board->setAnalogInput(solar, (conversion - 1) * 64);
+    runUntil(conversionAt(conversion) - 1);
+    TEST_ASSERT_EQUAL(0, AnalogSampler::value(0));
+    runUntil(conversionAt(conversion));
+  }
+  TEST_ASSERT_EQUAL(1920 / 4, AnalogSampler::value(0)); // a quarter of the way from 0
+}
+
+void test_noise_averages_out(void) {
+  board->setAnalogInput(solar, 500);
+  AnalogSampler::attach(solar);
+  begin();
+
+  for (unsigned long conversion = 1; conversion <= 10 * analogOversample; conversion++) {
+    const int noise[] = {+40, -40, +7, -7, +300, -300, -1, +1};
+    board->setAnalogInput(solar, 500 + noise[conversion % 8]);
+    runUntil(conversionAt(conversion));
+    TEST_ASSERT_EQUAL(2000, AnalogSampler::value(0));
+    TEST_ASSERT_EQUAL(500, AnalogSampler::read(0));
+  }
+}
+
+void test_step_settles(void) {
+  board->setAnalogInput(solar, 200);
+  board->setAnalogInput(knob, 700);
+  AnalogSampler::attach(solar);
+  AnalogSampler::attach(knob);
+  begin();
+  board->setAnalogInput(solar, 800);
+
+  // with two channels the solar array gets every other conversion, so a sample every 32
+  const unsigned long perSample = 2 * analogOversample;
+  for (int samples = 1; samples <= 40; samples++) {
+    unsigned long last = (samples - 1) * perSample + 2 * analogOversample - 1;
+    runUntil(conversionAt(last) - 1);
+    uint16_t before = AnalogSampler::value(0);
+    runUntil(conversionAt(last));
+    uint16_t after = AnalogSampler::value(0);
+    TEST_ASSERT_TRUE(after >= before);
+
+    double expected = 3200 - 2400 * pow(0.75, samples);
+    TEST_ASSERT_TRUE(fabs(after - expected) <= 2.0);
+    if (samples == 4) { // the time constant: 131ms
+      TEST_ASSERT_TRUE(after > 800 + 2400 * 0.68);
+    }
+    TEST_ASSERT_EQUAL(2800, AnalogSampler::value(1)); // the knob has not moved
+  }
+  TEST_ASSERT_EQUAL(3200, AnalogSampler::value(0));
+  TEST_ASSERT_EQUAL(800, AnalogSampler::read(0));
+}
+
+void test_reads_between_conversions_do_not_convert(void) {
+  board->setAnalogInput(solar, 1023);
+  AnalogSampler::attach(solar);
+  begin();
+  board->setAnalogInput(solar, 0);
+
+  unsigned long reads = board->analogReads();
+  for (int i = 0; i < 100; i++) {
+    AnalogSampler::value(0); // the same instant: no conversion is owed
+  }
+  TEST_ASSERT_EQUAL(reads, board->analogReads());
+  TEST_ASSERT_EQUAL(analogValueMax, AnalogSampler::value(0));
+
+  runUntil(conversionAt(analogOversample));
+  TEST_ASSERT_EQUAL(analogValueMax - analogValueMax / 4, AnalogSampler::value(0));
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_begin_seeds_each_channel);
+  RUN_TEST(test_a_sample_is_sixteen_conversions);
+  RUN_TEST(test_noise_averages_out);
+  RUN_TEST(test_step_settles);
+  RUN_TEST(test_reads_between_conversions_do_not_convert);
+  return UNITY_END();
+}
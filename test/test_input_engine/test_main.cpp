@@ -0,0 +1,108 @@
+/*
+    test_main.cpp (test_input_engine)
+    2026-10-17
+
+    InputEngine's debounce and timestamps (see input_engine.h), with a bouncing contact driven on
+        a simulated board:
+        a bouncing press and release each give one event, stamped with the burst's first edge
+        a glitch that settles back is no event, and the next burst is stamped from its own start
+        a long press is timed from the first edge too
+
+    pio test -e native -f test_input_engine
+*/
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include "input_engine.h"
+#include "sim_board.h"
+
+const uint8_t contactPin = 30; // nothing else is attached here
+const uint8_t debounceMillis = 20;
+const uint16_t longPressMillis = 1000;
+
+static SimBoard *board;
+static SimBoard::Scope *scope;
+static int8_t channel;
+
+// level changes at the given millis, then time moves on to settle
+static void drive(const unsigned long *at, uint8_t edges, int firstLevel, unsigned long settle) {
+  int level = firstLevel;
+  for (uint8_t i = 0; i < edges; i++) {
+    board->advanceMillis(at[i] - board->millis());
+    board->setInput(contactPin, level);
+    level = !level;
+  }
+  board->advanceMillis(settle);
+}
+
+static void assertEvent(InputEventType type, unsigned long millis) {
+  InputEvent event;
+  TEST_ASSERT_TRUE(InputEngine::read(event));
+  TEST_ASSERT_EQUAL(channel, event.source);
+  TEST_ASSERT_EQUAL(type, event.payload);
+  TEST_ASSERT_EQUAL(millis, event.millis);
+}
+
+static void assertNoEvent(void) {
+  InputEvent event;
+  TEST_ASSERT_FALSE(InputEngine::read(event));
+}
+
+void setUp(void) {
+  board = new SimBoard();
+  scope = new SimBoard::Scope(*board);
+  board->setInput(contactPin, LOW);
+  channel = InputEngine::attach(contactPin, true, debounceMillis, longPressMillis);
+  InputEngine::begin();
+}
+
+void tearDown(void) {
+  delete scope;
+  delete board;
+}
+
+void test_bouncing_press_is_stamped_at_first_edge(void) {
+  const unsigned long press[] = {100, 102, 104, 107, 109}; // ends HIGH
+  drive(press, 5, HIGH, 50);
+  assertEvent(InputTurnedOn, 100);
+  assertNoEvent();
+  TEST_ASSERT_TRUE(InputEngine::isOn(channel));
+
+  const unsigned long release[] = {500, 501, 503}; // ends LOW
+  drive(release, 3, LOW, 50);
+  assertEvent(InputTurnedOff, 500);
+  assertNoEvent();
+  TEST_ASSERT_FALSE(InputEngine::isOn(channel));
+}
+
+void test_glitch_is_not_a_burst_start(void) {
+  const unsigned long glitch[] = {100, 103}; // HIGH for 3ms, back to LOW
+  drive(glitch, 2, HIGH, 0);
+  board->advanceMillis(200 - board->millis());
+  assertNoEvent();
+
+  const unsigned long press[] = {200, 201, 205};
+  drive(press, 3, HIGH, 50);
+  assertEvent(InputTurnedOn, 200);
+  assertNoEvent();
+}
+
+void test_long_press_timed_from_first_edge(void) {
+  const unsigned long press[] = {100, 104, 108};
+  drive(press, 3, HIGH, 50);
+  assertEvent(InputTurnedOn, 100);
+
+  board->advanceMillis(100 + longPressMillis - 1 - board->millis());
+  assertNoEvent();
+  board->advanceMillis(1);
+  assertEvent(InputHeld, 100 + longPressMillis);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_bouncing_press_is_stamped_at_first_edge);
+  RUN_TEST(test_glitch_is_not_a_burst_start);
+  RUN_TEST(test_long_press_timed_from_first_edge);
+  return UNITY_END();
+}
@@ -0,0 +1,192 @@
+/*
+    test_main.cpp (test_lcd_framebuffer)
+    2026-10-17
+
+    LCDFrameBuffer in front of a LiquidCrystal_I2C on the simulated PCF8574/HD44780 panel, counting
+        what reaches the panel (SimLCD's commands and characters):
+        cells that have not changed are never sent again
+        changed cells go out as runs, one setCursor() each; a single unchanged cell between two
+            changes is rewritten rather than skipped
+        a run that starts where the panel's address counter already is needs no setCursor()
+        invalidate() rewrites every cell; nothing is sent until an initAsync() panel is ready
+
+    pio test -e native -f test_lcd_framebuffer
+*/
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include "lcd_framebuffer.h"
+#include "sim_board.h"
+#include "sim_lcd.h"
+
+const uint8_t panelAddress = 0x27;
+
+static SimBoard *board;
+static SimBoard::Scope *scope;
+static SimLCD *lcd;
+static LiquidCrystal_I2C *panel;
+static LCDFrameBuffer *frame;
+static unsigned long commands;
+static unsigned long characters;
+
+// what reached the panel since the last call
+static unsigned long commandsSent(void) {
+  unsigned long sent = lcd->commands() - commands;
+  commands = lcd->commands();
+  return sent;
+}
+
+static unsigned long charactersSent(void) {
+  unsigned long sent = lcd->characters() - characters;
+  characters = lcd->characters();
+  return sent;
+}
+
+static void resetCounts(void) {
+  commandsSent();
+  charactersSent();
+}
+
+void setUp(void) {
+  board = new SimBoard();
+  scope = new SimBoard::Scope(*board);
+  lcd = new SimLCD(lcdFrameColumns, lcdFrameRows);
+  board->attachI2C(panelAddress, lcd);
+  panel = new LiquidCrystal_I2C(panelAddress, lcdFrameColumns, lcdFrameRows);
+  frame = new LCDFrameBuffer(*panel);
+  panel->init();
+  frame->panelCleared();
+  resetCounts();
+}
+
+void tearDown(void) {
+  delete frame;
+  delete panel;
+  delete lcd;
+  delete scope;
+  delete board;
+}
+
+void test_unchanged_cells_are_not_resent(void) {
+  frame->setCursor(0, 0);
+  frame->print("Hello");
+  TEST_ASSERT_EQUAL(5, frame->update());
+  TEST_ASSERT_EQUAL(5, charactersSent());
+  TEST_ASSERT_EQUAL_STRING("Hello           ", lcd->text(0).c_str());
+
+  TEST_ASSERT_EQUAL(0, frame->update());
+  frame->setCursor(0, 0);
+  frame->print("Hello"); // drawn again, as the status display is every tick
+  TEST_ASSERT_EQUAL(0, frame->update());
+  TEST_ASSERT_EQUAL(0, charactersSent());
+  TEST_ASSERT_EQUAL(0, commandsSent());
+
+  frame->setCursor(0, 0);
+  frame->print("Help!");
+  TEST_ASSERT_EQUAL(2, frame->update());
+  TEST_ASSERT_EQUAL(2, charactersSent());
+  TEST_ASSERT_EQUAL_STRING("Help!           ", lcd->text(0).c_str());
+}
+
+void test_changes_coalesce_into_runs(void) {
+  frame->setCursor(2, 0);
+  frame->print('a');
+  frame->setCursor(4, 0);
+  frame->print('b'); // one unchanged cell between: rewritten, in a single run
+  TEST_ASSERT_EQUAL(3, frame->update());
+  TEST_ASSERT_EQUAL(1, commandsSent());
+  TEST_ASSERT_EQUAL(3, charactersSent());
+
+  frame->setCursor(2, 0);
+  frame->print('c');
+  frame->setCursor(9, 0);
+  frame->print('d'); // far apart: two runs
+  TEST_ASSERT_EQUAL(2, frame->update());
+  TEST_ASSERT_EQUAL(2, commandsSent());
+  TEST_ASSERT_EQUAL(2, charactersSent());
+  TEST_ASSERT_EQUAL_STRING("  c b    d      ", lcd->text(0).c_str());
+
+  frame->setCursor(15, 0);
+  frame->print('e');
+  frame->setCursor(0, 1);
+  frame->print('f'); // adjacent in the frame, but on another row of the panel
+  TEST_ASSERT_EQUAL(2, frame->update());
+  TEST_ASSERT_EQUAL(2, commandsSent());
+  TEST_ASSERT_EQUAL_STRING("  c b    d     e", lcd->text(0).c_str());
+  TEST_ASSERT_EQUAL_STRING("f               ", lcd->text(1).c_str());
+}
+
+void test_cursor_moves_are_tracked(void) {
+  frame->setCursor(3, 1);
+  frame->print("abc");
+  TEST_ASSERT_EQUAL(3, frame->update());
+  TEST_ASSERT_EQUAL(1, commandsSent());
+
+  frame->print("de"); // carries on from where the panel's address counter was left
+  TEST_ASSERT_EQUAL(2, frame->update());
+  TEST_ASSERT_EQUAL(0, commandsSent());
+
+  frame->setCursor(3, 1);
+  frame->print('x'); // behind the counter: has to move it back
+  TEST_ASSERT_EQUAL(1, frame->update());
+  TEST_ASSERT_EQUAL(1, commandsSent());
+  TEST_ASSERT_EQUAL_STRING("   xbcde        ", lcd->text(1).c_str());
+
+  frame->print('y');
+  TEST_ASSERT_EQUAL(1, frame->update());
+  TEST_ASSERT_EQUAL(0, commandsSent());
+  TEST_ASSERT_EQUAL_STRING("   xycde        ", lcd->text(1).c_str());
+}
+
+void test_writes_past_the_row_are_dropped(void) {
+  frame->setCursor(12, 0);
+  frame->print("overflow");
+  TEST_ASSERT_EQUAL(4, frame->update());
+  TEST_ASSERT_EQUAL_STRING("            over", lcd->text(0).c_str());
+  TEST_ASSERT_EQUAL_STRING("                ", lcd->text(1).c_str());
+}
+
+void test_invalidate_rewrites_everything(void) {
+  frame->setCursor(0, 0);
+  frame->print("T 12");
+  frame->update();
+  resetCounts();
+
+  frame->invalidate();
+  TEST_ASSERT_EQUAL(lcdFrameColumns * lcdFrameRows, frame->update());
+  TEST_ASSERT_EQUAL(lcdFrameColumns * lcdFrameRows, charactersSent());
+  TEST_ASSERT_EQUAL(2, commandsSent()); // a setCursor() for each row
+  TEST_ASSERT_EQUAL_STRING("T 12            ", lcd->text(0).c_str());
+}
+
+void test_nothing_sent_before_the_panel_is_ready(void) {
+  panel->initAsync();
+  frame->invalidate();
+  frame->clear();
+  frame->print("Booting");
+  TEST_ASSERT_EQUAL(0, frame->update());
+
+  unsigned long waited = 0;
+  while (!panel->poll()) {
+    TEST_ASSERT_EQUAL(0, frame->update());
+    board->advanceMillis(1);
+    TEST_ASSERT_TRUE(++waited < 5000);
+  }
+  frame->panelCleared();
+  resetCounts();
+  TEST_ASSERT_EQUAL(7, frame->update());
+  TEST_ASSERT_EQUAL(7, charactersSent());
+  TEST_ASSERT_EQUAL_STRING("Booting         ", lcd->text(0).c_str());
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_unchanged_cells_are_not_resent);
+  RUN_TEST(test_changes_coalesce_into_runs);
+  RUN_TEST(test_cursor_moves_are_tracked);
+  RUN_TEST(test_writes_past_the_row_are_dropped);
+  RUN_TEST(test_invalidate_rewrites_everything);
+  RUN_TEST(test_nothing_sent_before_the_panel_is_ready);
+  return UNITY_END();
+}
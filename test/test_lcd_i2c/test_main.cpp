@@ -0,0 +1,192 @@
+/*
+    test_main.cpp (test_lcd_i2c)
+    2026-10-17
+
+    LiquidCrystal_I2C on the simulated PCF8574/HD44780 panel, with every transaction on the bus
+        recorded on its way to the panel:
+        the bulk write(const uint8_t *, size_t) puts the same bytes on the bus as a character at a
+            time, and leaves the same text, in far fewer transactions; runs longer than the Wire
+            buffer are split on character boundaries
+        initAsync() and poll() send the same transactions as the blocking init(), none sooner
+            after the one before than init() sends it, and ready() turns true with the last
+
+    pio test -e native -f test_lcd_i2c
+*/
+
+#include <Arduino.h>
+#include <string.h>
+#include <unity.h>
+#include <vector>
+
+#include "LiquidCrystal_I2C.h"
+#include "sim_board.h"
+#include "sim_lcd.h"
+
+const uint8_t bulkAddress = 0x26;
+const uint8_t perCharacterAddress = 0x27;
+const uint8_t bytesPerCharacter = 6;    // two nibbles, each three expander writes
+const uint8_t charactersPerTransaction = BUFFER_LENGTH / bytesPerCharacter;
+const uint8_t setCursorTransactions = 6; // a command goes out an expander write at a time
+
+// a panel that keeps a copy of every transaction it receives
+class RecordedLCD : public SimI2CDevice {
+public:
+  RecordedLCD(void) :
+      lcd(16, 2) {
+  }
+
+  virtual bool receive(const uint8_t *data, size_t length) {
+    bytes.insert(bytes.end(), data, data + length);
+    transactions.push_back(length);
+    times.push_back(micros());
+    return lcd.receive(data, length);
+  }
+
+  void forget(void) {
+    bytes.clear();
+    transactions.clear();
+    times.clear();
+  }
+
+  SimLCD lcd;
+  std::vector<uint8_t> bytes;
+  std::vector<size_t> transactions; // the length of each
+  std::vector<unsigned long> times;  // and when it arrived
+};
+
+static SimBoard *board;
+static SimBoard::Scope *scope;
+static RecordedLCD *bulk;
+static RecordedLCD *perCharacter;
+static LiquidCrystal_I2C *bulkPanel;
+static LiquidCrystal_I2C *perCharacterPanel;
+
+static void writeBoth(uint8_t column, uint8_t row, const char *text) {
+  bulkPanel->setCursor(column, row);
+  bulkPanel->write((const uint8_t *)text, strlen(text));
+  perCharacterPanel->setCursor(column, row);
+  for (const char *c = text; *c; c++) {
+    perCharacterPanel->write((uint8_t)*c);
+  }
+}
+
+static void assertSameOnBusAndPanel(void) {
+  TEST_ASSERT_EQUAL(perCharacter->bytes.size(), bulk->bytes.size());
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(perCharacter->bytes.data(), bulk->bytes.data(), bulk->bytes.size());
+  TEST_ASSERT_EQUAL_STRING(perCharacter->lcd.text(0).c_str(), bulk->lcd.text(0).c_str());
+  TEST_ASSERT_EQUAL_STRING(perCharacter->lcd.text(1).c_str(), bulk->lcd.text(1).c_str());
+  TEST_ASSERT_EQUAL(perCharacter->lcd.characters(), bulk->lcd.characters());
+}
+
+void setUp(void) {
+  board = new SimBoard();
+  scope = new SimBoard::Scope(*board);
+  bulk = new RecordedLCD();
+  perCharacter = new RecordedLCD();
+  board->attachI2C(bulkAddress, bulk);
+  board->attachI2C(perCharacterAddress, perCharacter);
+  bulkPanel = new LiquidCrystal_I2C(bulkAddress, 16, 2);
+  perCharacterPanel = new LiquidCrystal_I2C(perCharacterAddress, 16, 2);
+  bulkPanel->init();
+  perCharacterPanel->init();
+  bulk->forget();
+  perCharacter->forget();
+}
+
+void tearDown(void) {
+  delete bulkPanel;
+  delete perCharacterPanel;
+  delete bulk;
+  delete perCharacter;
+  delete scope;
+  delete board;
+}
+
+void test_bulk_write_matches_per_character(void) {
+  writeBoth(0, 0, "T     ");
+  writeBoth(2, 0, "1234");
+  writeBoth(0, 1, "B 87  S 42");
+  assertSameOnBusAndPanel();
+  TEST_ASSERT_EQUAL_STRING("T 1234          ", bulk->lcd.text(0).c_str());
+  TEST_ASSERT_EQUAL_STRING("B 87  S 42      ", bulk->lcd.text(1).c_str());
+  // 6, 4 and 10 characters: two, one and two transactions, against one per expander write
+  TEST_ASSERT_EQUAL(3 * setCursorTransactions + 5, bulk->transactions.size());
+  TEST_ASSERT_EQUAL(3 * setCursorTransactions + 20 * bytesPerCharacter, perCharacter->transactions.size());
+}
+
+void test_long_runs_split_on_characters(void) {
+  writeBoth(0, 0, "0123456789abcdef");
+  assertSameOnBusAndPanel();
+  TEST_ASSERT_EQUAL_STRING("0123456789abcdef", bulk->lcd.text(0).c_str());
+  TEST_ASSERT_EQUAL(setCursorTransactions + (16 + charactersPerTransaction - 1) / charactersPerTransaction,
+                    bulk->transactions.size());
+  for (size_t i = setCursorTransactions; i < bulk->transactions.size(); i++) {
+    TEST_ASSERT_TRUE(bulk->transactions[i] <= BUFFER_LENGTH);
+    TEST_ASSERT_EQUAL(0, bulk->transactions[i] % bytesPerCharacter);
+  }
+}
+
+void test_every_character_value_survives(void) {
+  uint8_t text[16];
+  for (int first = 0; first < 256; first += 16) {
+    for (uint8_t i = 0; i < 16; i++) {
+      text[i] = first + i;
+    }
+    bulkPanel->setCursor(0, 0);
+    bulkPanel->write(text, sizeof(text));
+    perCharacterPanel->setCursor(0, 0);
+    for (uint8_t i = 0; i < 16; i++) {
+      perCharacterPanel->write(text[i]);
+    }
+    assertSameOnBusAndPanel();
+  }
+}
+
+void test_async_init_matches_blocking_init(void) {
+  const unsigned long pollMicros = 10;
+  RecordedLCD blocking;
+  RecordedLCD async;
+  board->attachI2C(0x20, &blocking);
+  board->attachI2C(0x21, &async);
+  LiquidCrystal_I2C blockingPanel(0x20, 16, 2);
+  LiquidCrystal_I2C asyncPanel(0x21, 16, 2);
+
+  blockingPanel.init();
+  TEST_ASSERT_TRUE(blockingPanel.ready());
+
+  asyncPanel.initAsync();
+  TEST_ASSERT_FALSE(asyncPanel.ready());
+  unsigned long polls = 0;
+  while (!asyncPanel.poll()) {
+    TEST_ASSERT_FALSE(asyncPanel.ready());
+    board->advanceMicros(pollMicros);
+    TEST_ASSERT_TRUE(++polls < 1000000);
+  }
+  TEST_ASSERT_TRUE(asyncPanel.ready());
+  TEST_ASSERT_TRUE(asyncPanel.poll());
+
+  TEST_ASSERT_EQUAL(blocking.transactions.size(), async.transactions.size());
+  TEST_ASSERT_EQUAL_UINT8_ARRAY(blocking.bytes.data(), async.bytes.data(), blocking.bytes.size());
+  for (size_t i = 1; i < async.times.size(); i++) {
+    unsigned long blockingGap = blocking.times[i] - blocking.times[i - 1];
+    unsigned long asyncGap = async.times[i] - async.times[i - 1];
+    TEST_ASSERT_TRUE(asyncGap >= blockingGap);              // every power-on delay is honoured
+    TEST_ASSERT_TRUE(asyncGap <= blockingGap + pollMicros); // and waited out no longer than a poll
+  }
+  TEST_ASSERT_TRUE(async.lcd.displayOn());
+  TEST_ASSERT_EQUAL(blocking.lcd.backlight(), async.lcd.backlight());
+  TEST_ASSERT_EQUAL_STRING(blocking.lcd.text(0).c_str(), async.lcd.text(0).c_str());
+
+  asyncPanel.setCursor(0, 1);
+  asyncPanel.print("up");
+  TEST_ASSERT_EQUAL_STRING("up              ", async.lcd.text(1).c_str());
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_bulk_write_matches_per_character);
+  RUN_TEST(test_long_runs_split_on_characters);
+  RUN_TEST(test_every_character_value_survives);
+  RUN_TEST(test_async_init_matches_blocking_init);
+  return UNITY_END();
+}
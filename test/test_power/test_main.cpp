@@ -0,0 +1,198 @@
+/*
+    test_main.cpp (test_power)
+    2026-10-17
+
+    The fixed point battery and solar model (see fixed_percent.h) against the double model it
+        replaced, kept here as it was in power.cpp and photoresistor.cpp:
+            every ADC value through PhotoResistor
+            random day and night sequences of charging and light loads through HouseBattery
+
+    The double model drifts by a few ulps from values that are exact in FixedPercent (1/2.55,
+        say), enough to land on 9.9999999 instead of 10 and flip a threshold.  That drift is what
+        the fixed model removes, so the replay snaps the double battery back onto the nearest
+        1/255th of a percent when it is within 1e-6 of it; any real difference is 1/255th or more.
+
+    pio test -e native -f test_power
+*/
+
+#include <Arduino.h>
+#include <math.h>
+#include <unity.h>
+
+#include "fixed_percent.h"
+#include "photoresistor.h"
+#include "pins.h"
+#include "power.h"
+#include "sim_board.h"
+
+// the double model, as it was
+namespace before {
+
+const double maximumBatteryPower = 100.0;
+const double chargingThreshold = 90.0;
+const double prettyFullThreshold = 80.0;
+const double lowThreshold = 25.0;
+const double criticalThreshold = 10.0;
+const int interiorLightsPowerUsage = 1;
+const int exteriorLightsPowerUsage = 3;
+
+double photoResistorValue(int reading) {
+  int lightLevel = reading;
+  lightLevel = map(lightLevel, 200, 1000, 0, 255);
+  lightLevel = constrain(lightLevel, 0, 255);
+  return ((double)lightLevel) / 2.55;
+}
+
+class HouseBattery {
+public:
+  HouseBattery(void) {
+    _battery = 0.0;
+    _charging = false;
+  }
+
+  double batteryLevel(void) {
+    return _battery;
+  }
+
+  HouseBatteryPowerLevel powerLevel(void) {
+    if (_battery < criticalThreshold) {
+      return PowerCritical;
+    }
+    else if (_battery < lowThreshold) {
+      return PowerLow;
+    }
+    else if (_battery < prettyFullThreshold) {
+      return PowerMiddle;
+    }
+    else if (_battery < chargingThreshold) {
+      return PowerNearFull;
+    }
+    else {
+      return PowerFull;
+    }
+  }
+
+  bool isCharging(void) {
+    return _charging;
+  }
+
+  void chargeBattery(double solarPower) {
+    if (!_charging) {
+      if (_battery < chargingThreshold) {
+        _charging = true;
+      }
+    }
+
+    double solar = solarPower / 50;
+    if (_charging) {
+      _battery += solar;
+      _battery = min(_battery, maximumBatteryPower);
+      if (_battery == maximumBatteryPower) {
+        _charging = false;
+      }
+    }
+  }
+
+  void usePower(double powerUsed) {
+    _battery -= powerUsed;
+    _battery = max(_battery, 0.0);
+  }
+
+  // not in the original: see above
+  void snap(void) {
+    double scaled = _battery * fixedPercentScale;
+    double nearest = nearbyint(scaled);
+    if (fabs(scaled - nearest) < 1e-6) {
+      _battery = nearest / fixedPercentScale;
+    }
+  }
+
+private:
+  double _battery;
+  bool _charging;
+};
+
+} // namespace before
+
+// a small LCG, so the sequence is the same on every host
+static uint32_t randomState;
+
+static uint32_t nextRandom(void) {
+  randomState = randomState * 1664525UL + 1013904223UL;
+  return randomState >> 8;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_every_adc_value(void) {
+  PhotoResistor solarArray(solarArrayAnalogInputPin);
+  for (int reading = 0; reading <= 1023; reading++) {
+    SimBoard::active().setAnalogInput(solarArrayAnalogInputPin, reading);
+    FixedPercent fixed = solarArray.value();
+    double expected = before::photoResistorValue(reading);
+
+    TEST_ASSERT_TRUE_MESSAGE(fabs((double)fixed / fixedPercentScale - expected) < 1e-9, "reading differs");
+    // what the charge step, solar / 50, adds
+    TEST_ASSERT_TRUE_MESSAGE(fabs((double)(fixed / MegaPanel::solarChargeDivisor) / fixedPercentScale - expected / 50) <
+                                 1e-9,
+                             "charge step differs");
+  }
+}
+
+void test_random_charge_and_use(void) {
+  HouseBattery fixed;
+  before::HouseBattery reference;
+  unsigned long levelSteps[PowerFull + 1] = {0};
+  unsigned long chargingStarts = 0;
+  bool wasCharging = false;
+
+  randomState = 2026;
+  for (unsigned long step = 0; step < 200000; step++) {
+    // days and nights of 300 charging steps, clouds by the step
+    bool day = (step / 300) % 2 == 0;
+    int reading = day ? 200 + nextRandom() % 824 : nextRandom() % 240;
+    SimBoard::active().setAnalogInput(solarArrayAnalogInputPin, reading);
+    PhotoResistor solarArray(solarArrayAnalogInputPin);
+    fixed.chargeBattery(solarArray.value());
+    reference.chargeBattery(before::photoResistorValue(reading));
+
+    uint32_t loads = nextRandom();
+    if (loads % 4 == 0) {
+      fixed.usePower(MegaPanel::interiorLightsPowerUsage);
+      reference.usePower(before::interiorLightsPowerUsage);
+    }
+    if (loads / 4 % 8 == 0) {
+      fixed.usePower(MegaPanel::exteriorLightsPowerUsage);
+      reference.usePower(before::exteriorLightsPowerUsage);
+    }
+    reference.snap();
+
+    TEST_ASSERT_EQUAL_MESSAGE(lround(reference.batteryLevel() * fixedPercentScale), fixed.batteryLevel(),
+                              "battery differs");
+    TEST_ASSERT_EQUAL_MESSAGE(reference.powerLevel(), fixed.powerLevel(), "power level differs");
+    TEST_ASSERT_EQUAL_MESSAGE(reference.isCharging(), fixed.isCharging(), "charging differs");
+    TEST_ASSERT_EQUAL_MESSAGE((int)reference.batteryLevel(), wholePercent(fixed.batteryLevel()),
+                              "displayed percent differs");
+
+    levelSteps[fixed.powerLevel()]++;
+    if (fixed.isCharging() && !wasCharging) {
+      chargingStarts++;
+    }
+    wasCharging = fixed.isCharging();
+  }
+
+  // the sequence went through everything it compares
+  for (int level = PowerCritical; level <= PowerFull; level++) {
+    TEST_ASSERT_GREATER_THAN(0, levelSteps[level]);
+  }
+  TEST_ASSERT_GREATER_THAN(100, chargingStarts);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_every_adc_value);
+  RUN_TEST(test_random_charge_and_use);
+  return UNITY_END();
+}
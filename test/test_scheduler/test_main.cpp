@@ -0,0 +1,124 @@
+/*
+    test_main.cpp (test_scheduler)
+    2026-10-17
+
+    TaskScheduler's period and phase across the points where a tick count can wrap:
+        32767 to 32768, where the Mega's int tick count used to go negative
+        2^32 - 1 to 0, where TickCount itself wraps
+
+    pio test -e native -f test_scheduler
+*/
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include "scheduler.h"
+
+class Recorder {
+public:
+  void everyOther(TickCount tickCount) {
+    record(_everyOther, _everyOtherCount, tickCount);
+  }
+  void everyFourth(TickCount tickCount) {
+    record(_everyFourth, _everyFourthCount, tickCount);
+  }
+  void everyTenth(TickCount tickCount) {
+    record(_everyTenth, _everyTenthCount, tickCount);
+  }
+
+  TickCount _everyOther[64];
+  uint8_t _everyOtherCount = 0;
+  TickCount _everyFourth[64];
+  uint8_t _everyFourthCount = 0;
+  TickCount _everyTenth[64];
+  uint8_t _everyTenthCount = 0;
+
+private:
+  void record(TickCount *ticks, uint8_t &count, TickCount tickCount) {
+    if (count < 64) {
+      ticks[count++] = tickCount;
+    }
+  }
+};
+
+// as the status display and the charging task are scheduled (see dwelling_config.h)
+static const ScheduledTask<Recorder> everyOther = {"everyOther", &Recorder::everyOther, 2, 1, 1, 50000};
+static const ScheduledTask<Recorder> everyFourth = {"everyFourth", &Recorder::everyFourth, 4, 3, 2, 50000};
+static const ScheduledTask<Recorder> everyTenth = {"everyTenth", &Recorder::everyTenth, 10, 0, 3, 50000};
+
+static void runTicks(TaskScheduler<Recorder, 3> &scheduler, TickCount first, uint8_t ticks) {
+  TickCount tickCount = first;
+  for (uint8_t i = 0; i < ticks; i++) {
+    scheduler.run(tickCount++);
+  }
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_phase_holds_past_32767(void) {
+  Recorder recorder;
+  TaskScheduler<Recorder, 3> scheduler(recorder);
+  TEST_ASSERT_TRUE(scheduler.addTask(everyOther));
+  TEST_ASSERT_TRUE(scheduler.addTask(everyFourth));
+  TEST_ASSERT_TRUE(scheduler.addTask(everyTenth));
+
+  runTicks(scheduler, 32760, 40); // 32760 .. 32799
+
+  TEST_ASSERT_EQUAL(20, recorder._everyOtherCount);
+  for (uint8_t i = 0; i < recorder._everyOtherCount; i++) {
+    TEST_ASSERT_EQUAL(32761 + 2 * i, recorder._everyOther[i]);
+  }
+  TEST_ASSERT_EQUAL(10, recorder._everyFourthCount);
+  for (uint8_t i = 0; i < recorder._everyFourthCount; i++) {
+    TEST_ASSERT_EQUAL(32763 + 4 * i, recorder._everyFourth[i]);
+  }
+  TEST_ASSERT_EQUAL(4, recorder._everyTenthCount);
+  for (uint8_t i = 0; i < recorder._everyTenthCount; i++) {
+    TEST_ASSERT_EQUAL(32760 + 10 * i, recorder._everyTenth[i]);
+  }
+}
+
+void test_phase_holds_across_tick_count_wrap(void) {
+  Recorder recorder;
+  TaskScheduler<Recorder, 3> scheduler(recorder);
+  TEST_ASSERT_TRUE(scheduler.addTask(everyOther));
+  TEST_ASSERT_TRUE(scheduler.addTask(everyFourth));
+
+  runTicks(scheduler, (TickCount)-16, 32); // 2^32 - 16 .. 15
+
+  // periods dividing 2^32 keep their rhythm through the wrap
+  TEST_ASSERT_EQUAL(16, recorder._everyOtherCount);
+  for (uint8_t i = 1; i < recorder._everyOtherCount; i++) {
+    TEST_ASSERT_EQUAL(1, recorder._everyOther[i] % 2);
+    TEST_ASSERT_EQUAL(2, (TickCount)(recorder._everyOther[i] - recorder._everyOther[i - 1]));
+  }
+  TEST_ASSERT_EQUAL(8, recorder._everyFourthCount);
+  for (uint8_t i = 1; i < recorder._everyFourthCount; i++) {
+    TEST_ASSERT_EQUAL(4, (TickCount)(recorder._everyFourth[i] - recorder._everyFourth[i - 1]));
+  }
+}
+
+void test_wrap_restarts_other_periods_once(void) {
+  Recorder recorder;
+  TaskScheduler<Recorder, 3> scheduler(recorder);
+  TEST_ASSERT_TRUE(scheduler.addTask(everyTenth));
+
+  runTicks(scheduler, (TickCount)-20, 40); // 2^32 - 20 .. 19
+
+  // 2^32 - 16 and 2^32 - 6 (2^32 % 10 == 6), then 0, 10 from the wrap: one short period, never a lost task
+  TEST_ASSERT_EQUAL(4, recorder._everyTenthCount);
+  TEST_ASSERT_EQUAL((TickCount)-16, recorder._everyTenth[0]);
+  TEST_ASSERT_EQUAL((TickCount)-6, recorder._everyTenth[1]);
+  TEST_ASSERT_EQUAL(0, recorder._everyTenth[2]);
+  TEST_ASSERT_EQUAL(10, recorder._everyTenth[3]);
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_phase_holds_past_32767);
+  RUN_TEST(test_phase_holds_across_tick_count_wrap);
+  RUN_TEST(test_wrap_restarts_other_periods_once);
+  return UNITY_END();
+}
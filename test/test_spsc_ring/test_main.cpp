@@ -0,0 +1,159 @@
+/*
+    test_main.cpp (test_spsc_ring)
+    2026-10-17
+
+    SpscRing (see lib/SpscRing/src/spsc_ring.h):
+        a producer thread, standing in for the interrupt, against a consumer on the main thread:
+            every record arrives once, whole and in order
+        one thread: a full ring counts overflows and keeps what it had, the indices wrap past
+            256, runs of records go in whole or not at all and come out in order across the
+            wrap, drop() empties the ring
+
+    pio test -e native -f test_spsc_ring
+*/
+
+#include <Arduino.h>
+#include <thread>
+#include <unity.h>
+
+#include "spsc_ring.h"
+
+typedef EventRecord<uint32_t> SequencedRecord;
+
+// a record whose fields all follow from its sequence number, so a torn copy shows
+static SequencedRecord sequenced(uint32_t sequence) {
+  SequencedRecord record;
+  record.millis = sequence * 3UL;
+  record.source = (uint8_t)(sequence * 7);
+  record.payload = sequence;
+  return record;
+}
+
+static bool isSequenced(const SequencedRecord &record, uint32_t sequence) {
+  return record.millis == sequence * 3UL && record.source == (uint8_t)(sequence * 7) && record.payload == sequence;
+}
+
+void setUp(void) {}
+
+void tearDown(void) {}
+
+void test_two_threads_keep_every_record_in_order(void) {
+  const uint32_t records = 2000000;
+  SpscRing<SequencedRecord, 16> ring;
+  std::thread producer([&]() {
+    for (uint32_t i = 0; i < records; i++) {
+      while (ring.full()) {
+        std::this_thread::yield(); // the consumer is behind
+      }
+      ring.push(sequenced(i));
+    }
+  });
+
+  uint32_t expected = 0;
+  uint32_t damaged = 0;
+  SequencedRecord record;
+  while (expected < records) {
+    if (!ring.pop(record)) {
+      std::this_thread::yield();
+      continue;
+    }
+    if (!isSequenced(record, expected)) {
+      damaged++;
+    }
+    expected++;
+  }
+  producer.join();
+
+  TEST_ASSERT_EQUAL(0, damaged);
+  TEST_ASSERT_TRUE(ring.empty());
+  TEST_ASSERT_EQUAL(0, ring.overflows());
+}
+
+void test_full_ring_counts_overflows(void) {
+  SpscRing<SequencedRecord, 8> ring;
+  for (uint32_t i = 0; i < 8; i++) {
+    TEST_ASSERT_TRUE(ring.push(sequenced(i)));
+  }
+  TEST_ASSERT_TRUE(ring.full());
+  for (uint32_t i = 8; i < 11; i++) {
+    TEST_ASSERT_FALSE(ring.push(sequenced(i)));
+  }
+  TEST_ASSERT_EQUAL(3, ring.overflows());
+  TEST_ASSERT_EQUAL(8, ring.count());
+
+  // the records from before it filled, untouched
+  SequencedRecord record;
+  for (uint32_t i = 0; i < 8; i++) {
+    TEST_ASSERT_TRUE(ring.pop(record));
+    TEST_ASSERT_TRUE(isSequenced(record, i));
+  }
+  TEST_ASSERT_FALSE(ring.pop(record));
+}
+
+void test_indices_wrap(void) {
+  SpscRing<SequencedRecord, 4> ring;
+  SequencedRecord record;
+  uint32_t pushed = 0;
+  uint32_t popped = 0;
+  // three in, two out, so the count climbs to full and the indices pass 256 several times
+  while (popped < 1000) {
+    for (uint8_t i = 0; i < 3 && !ring.full(); i++) {
+      TEST_ASSERT_TRUE(ring.push(sequenced(pushed++)));
+    }
+    TEST_ASSERT_EQUAL(pushed - popped, ring.count());
+    for (uint8_t i = 0; i < 2; i++) {
+      TEST_ASSERT_TRUE(ring.pop(record));
+      TEST_ASSERT_TRUE(isSequenced(record, popped++));
+    }
+  }
+  TEST_ASSERT_EQUAL(0, ring.overflows());
+}
+
+void test_runs_wrap_whole_or_not_at_all(void) {
+  SpscRing<SequencedRecord, 8> ring;
+  SequencedRecord run[5];
+  SequencedRecord taken[8];
+  uint32_t pushed = 0;
+  uint32_t popped = 0;
+  // runs of five in and out of eight slots start at every offset, so some are split by the wrap
+  while (popped < 1000) {
+    for (uint8_t i = 0; i < 5; i++) {
+      run[i] = sequenced(pushed + i);
+    }
+    TEST_ASSERT_TRUE(ring.push(run, 5));
+    pushed += 5;
+    TEST_ASSERT_FALSE(ring.push(run, 4)); // only three free: nothing goes in
+    TEST_ASSERT_EQUAL(5, ring.count());
+    TEST_ASSERT_EQUAL(5, ring.pop(taken, 8));
+    for (uint8_t i = 0; i < 5; i++) {
+      TEST_ASSERT_TRUE(isSequenced(taken[i], popped++));
+    }
+    TEST_ASSERT_EQUAL(0, ring.pop(taken, 8));
+  }
+  TEST_ASSERT_EQUAL(4 * (pushed / 5), ring.overflows());
+}
+
+void test_drop_empties(void) {
+  SpscRing<SequencedRecord, 8> ring;
+  for (uint32_t i = 0; i < 5; i++) {
+    ring.push(sequenced(i));
+  }
+  ring.drop();
+  TEST_ASSERT_TRUE(ring.empty());
+
+  SequencedRecord record;
+  TEST_ASSERT_FALSE(ring.pop(record));
+  TEST_ASSERT_TRUE(ring.push(sequenced(5)));
+  TEST_ASSERT_TRUE(ring.pop(record));
+  TEST_ASSERT_TRUE(isSequenced(record, 5));
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_two_threads_keep_every_record_in_order);
+  RUN_TEST(test_full_ring_counts_overflows);
+  RUN_TEST(test_indices_wrap);
+  RUN_TEST(test_runs_wrap_whole_or_not_at_all);
+  RUN_TEST(test_drop_empties);
+  return UNITY_END();
+}
@@ -0,0 +1,186 @@
+/*
+    test_main.cpp (test_state_journal)
+    2026-10-17
+
+    StateJournal's recovery (see state_journal.h) on simulated boards.  A reset is a fresh board
+        with the old one's EEPROM copied in: RAM, the journal's own state included, starts over.
+        an erased or foreign EEPROM restores nothing
+        the newest record comes back after a reset
+        a record torn at any byte leaves the one before it standing
+        sequence numbers wrap, and the slots wear evenly
+        records wait for journalIntervalMillis unless asked for now, and repeat nothing
+
+    pio test -e native -f test_state_journal
+*/
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include "sim_board.h"
+#include "state_journal.h"
+
+const uint16_t journalBytes = journalSlots * 8;
+
+static SimBoard *board;
+static SimBoard::Scope *scope;
+
+// a new board holding this one's EEPROM, now the active one
+static void reset(void) {
+  SimBoard *next = new SimBoard();
+  for (uint16_t address = 0; address < simEEPROMSize; address++) {
+    uint8_t value = board->eepromRead(address);
+    if (value != 0xFF) {
+      next->eepromWrite(address, value);
+    }
+  }
+  delete scope;
+  delete board;
+  board = next;
+  scope = new SimBoard::Scope(*board);
+}
+
+static PersistentState persistent(FixedPercent battery, bool charging, uint8_t unlockFailures) {
+  PersistentState state;
+  state.battery = battery;
+  state.charging = charging;
+  state.unlockFailures = unlockFailures;
+  return state;
+}
+
+// service() until the record under way is complete, as loop() would between ticks
+static void finishRecord(void) {
+  unsigned long before = StateJournal::records();
+  for (uint8_t i = 0; i < 20 && StateJournal::records() == before; i++) {
+    StateJournal::service();
+    board->advanceMicros(simEEPROMWriteMicros);
+  }
+  TEST_ASSERT_EQUAL(before + 1, StateJournal::records());
+}
+
+static void saveNow(const PersistentState &state) {
+  StateJournal::save(state, true);
+  finishRecord();
+}
+
+static void assertRestores(const PersistentState &expected) {
+  PersistentState state = persistent(0, false, 0);
+  TEST_ASSERT_TRUE(StateJournal::restore(state));
+  TEST_ASSERT_EQUAL(expected.battery, state.battery);
+  TEST_ASSERT_EQUAL(expected.charging, state.charging);
+  TEST_ASSERT_EQUAL(expected.unlockFailures, state.unlockFailures);
+}
+
+void setUp(void) {
+  board = new SimBoard();
+  scope = new SimBoard::Scope(*board);
+}
+
+void tearDown(void) {
+  delete scope;
+  delete board;
+}
+
+void test_erased_or_foreign_restores_nothing(void) {
+  PersistentState state = persistent(1234, true, 2);
+  TEST_ASSERT_FALSE(StateJournal::restore(state));
+  TEST_ASSERT_EQUAL(1234, state.battery); // untouched
+
+  uint32_t noise = 12345;
+  for (uint16_t address = 0; address < journalBytes; address++) {
+    noise = noise * 1664525UL + 1013904223UL;
+    board->eepromWrite(address, noise >> 24);
+  }
+  reset();
+  TEST_ASSERT_FALSE(StateJournal::restore(state));
+  TEST_ASSERT_EQUAL(1234, state.battery);
+}
+
+void test_newest_record_survives_reset(void) {
+  saveNow(persistent(fixedPercent(40), true, 0));
+  saveNow(persistent(fixedPercent(41), false, 3));
+  reset();
+  assertRestores(persistent(fixedPercent(41), false, 3));
+
+  // and the journal carries on after the restored record
+  saveNow(persistent(fixedPercent(42), true, 1));
+  reset();
+  assertRestores(persistent(fixedPercent(42), true, 1));
+}
+
+void test_torn_record_keeps_the_one_before(void) {
+  const PersistentState good = persistent(fixedPercent(60), true, 1);
+  for (uint8_t written = 0; written < 8; written++) {
+    tearDown();
+    setUp();
+    saveNow(good);
+
+    // reset after only some of the next record's bytes reach the EEPROM
+    StateJournal::save(persistent(fixedPercent(20), false, 4), true);
+    for (uint8_t i = 0; i < written; i++) {
+      StateJournal::service();
+      board->advanceMicros(simEEPROMWriteMicros);
+    }
+    TEST_ASSERT_EQUAL(1, StateJournal::records());
+    reset();
+    assertRestores(good);
+  }
+}
+
+void test_sequence_wraps_and_slots_wear_evenly(void) {
+  // past the 16 bit sequence number's wrap, so the newest has a smaller number than many
+  const unsigned long records = 70000;
+  for (unsigned long i = 0; i < records; i++) {
+    saveNow(persistent(i % 25501, i % 2 == 0, i % 7));
+  }
+  unsigned long least = 0xFFFFFFFF;
+  unsigned long most = 0;
+  for (uint16_t address = 0; address < journalBytes; address += 8) {
+    unsigned long wear = board->eepromWrites(address); // the sequence number changes every time
+    least = wear < least ? wear : least;
+    most = wear > most ? wear : most;
+  }
+  TEST_ASSERT_EQUAL(records / journalSlots, least);
+  TEST_ASSERT_TRUE(most - least <= 1);
+
+  reset();
+  unsigned long last = records - 1;
+  assertRestores(persistent(last % 25501, last % 2 == 0, last % 7));
+}
+
+void test_interval_and_repeats(void) {
+  saveNow(persistent(fixedPercent(50), true, 0));
+
+  // the same state again: nothing to write
+  StateJournal::save(persistent(fixedPercent(50), true, 0), true);
+  for (uint8_t i = 0; i < 20; i++) {
+    StateJournal::service();
+    board->advanceMicros(simEEPROMWriteMicros);
+  }
+  TEST_ASSERT_EQUAL(1, StateJournal::records());
+
+  // a battery change waits out the interval
+  StateJournal::save(persistent(fixedPercent(51), true, 0), false);
+  board->advanceMillis(journalIntervalMillis - 1000);
+  StateJournal::service();
+  board->advanceMicros(simEEPROMWriteMicros);
+  StateJournal::service();
+  TEST_ASSERT_EQUAL(1, StateJournal::records());
+  board->advanceMillis(1000);
+  finishRecord();
+
+  // a PIN failure does not
+  StateJournal::save(persistent(fixedPercent(51), true, 1), true);
+  finishRecord();
+  reset();
+  assertRestores(persistent(fixedPercent(51), true, 1));
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_erased_or_foreign_restores_nothing);
+  RUN_TEST(test_newest_record_survives_reset);
+  RUN_TEST(test_torn_record_keeps_the_one_before);
+  RUN_TEST(test_sequence_wraps_and_slots_wear_evenly);
+  RUN_TEST(test_interval_and_repeats);
+  return UNITY_END();
+}
@@ -0,0 +1,224 @@
+/*
+    test_main.cpp (test_telemetry)
+    2026-10-17
+
+    Telemetry framing (see telemetry.h, crc8.h), read back from the simulated Serial:
+        CRC-8 against the published check value
+        records round trip through COBS, zero bytes and all, and no frame holds a zero
+        decodeFrame() rejects damaged, truncated and oversized frames
+        a reader joining mid-stream picks up at the next zero
+        a full queue drops whole frames and reports them once there is room
+        background() frames leave room for a tick, and are never counted as dropped
+
+    Each test runs on a fresh board, so it starts with an empty telemetry queue.
+
+    pio test -e native -f test_telemetry
+*/
+
+#include <Arduino.h>
+#include <string.h>
+#include <string>
+#include <unity.h>
+#include <vector>
+
+#include "crc8.h"
+#include "sim_board.h"
+#include "telemetry.h"
+
+static SimBoard *board;
+static SimBoard::Scope *scope;
+
+// everything pumped out since the last call, split at the zeros; a partial frame at the end is kept
+static std::vector<std::string> sentFrames(void) {
+  while (Telemetry::pending() != 0) {
+    Telemetry::pump();
+  }
+  std::vector<std::string> frames;
+  std::string frame;
+  std::string &sent = board->serialOutput();
+  for (size_t i = 0; i < sent.size(); i++) {
+    if (sent[i] == 0) {
+      frames.push_back(frame);
+      frame.clear();
+    }
+    else {
+      frame += sent[i];
+    }
+  }
+  sent.clear();
+  return frames;
+}
+
+static uint8_t decode(const std::string &frame, uint8_t *record, uint8_t maxLength) {
+  return Telemetry::decodeFrame((const uint8_t *)frame.data(), frame.size(), record, maxLength);
+}
+
+static TelemetryTickRecord tickRecord(uint16_t tickCount) {
+  TelemetryTickRecord record;
+  memset(&record, 0, sizeof(record));
+  record.tickCount = tickCount;
+  record.battery = 0x1234;
+  record.solar = 0x00FF;
+  record.flags = telemetryCharging;
+  return record;
+}
+
+void setUp(void) {
+  board = new SimBoard();
+  scope = new SimBoard::Scope(*board);
+}
+
+void tearDown(void) {
+  delete scope;
+  delete board;
+}
+
+void test_crc8_check_value(void) {
+  const char check[] = "123456789";
+  TEST_ASSERT_EQUAL(0xF4, crc8((const uint8_t *)check, 9)); // CRC-8, polynomial 0x07, initial 0
+  TEST_ASSERT_EQUAL(0, crc8(NULL, 0));
+}
+
+void test_tick_round_trips(void) {
+  TelemetryTickRecord record = tickRecord(0x0100); // zero bytes in the middle and at the ends
+  TEST_ASSERT_TRUE(Telemetry::tick(record));
+
+  std::vector<std::string> frames = sentFrames();
+  TEST_ASSERT_EQUAL(1, frames.size());
+  TEST_ASSERT_EQUAL(sizeof(record) + 2, frames[0].size()); // + CRC + COBS code, then the zero
+  TEST_ASSERT_EQUAL(std::string::npos, frames[0].find('\0'));
+
+  uint8_t decoded[telemetryMaxRecord];
+  TEST_ASSERT_EQUAL(sizeof(record), decode(frames[0], decoded, sizeof(decoded)));
+  TEST_ASSERT_EQUAL_MEMORY(&record, decoded, sizeof(record));
+}
+
+void test_event_round_trips(void) {
+  board->advanceMillis(70000); // a millis with zero and nonzero bytes
+  TEST_ASSERT_TRUE(Telemetry::event(TelemetryBadCode, -2));
+
+  std::vector<std::string> frames = sentFrames();
+  TEST_ASSERT_EQUAL(1, frames.size());
+  TelemetryEventRecord record;
+  TEST_ASSERT_EQUAL(sizeof(record), decode(frames[0], (uint8_t *)&record, sizeof(record)));
+  TEST_ASSERT_EQUAL(TelemetryEvent, record.type);
+  TEST_ASSERT_EQUAL(70000, record.millis);
+  TEST_ASSERT_EQUAL(TelemetryBadCode, record.code);
+  TEST_ASSERT_EQUAL(-2, record.value);
+}
+
+void test_damaged_frames_are_rejected(void) {
+  TelemetryTickRecord record = tickRecord(7);
+  Telemetry::tick(record);
+  std::string frame = sentFrames()[0];
+  uint8_t decoded[telemetryMaxRecord];
+
+  // every single bit flipped that leaves the frame free of zeros
+  for (size_t i = 0; i < frame.size(); i++) {
+    for (uint8_t bit = 0; bit < 8; bit++) {
+      std::string damaged = frame;
+      damaged[i] ^= 1 << bit;
+      if (damaged[i] != 0) {
+        TEST_ASSERT_EQUAL(0, decode(damaged, decoded, sizeof(decoded)));
+      }
+    }
+  }
+  // lost bytes: never the whole record (a short prefix may pass CRC-8 by chance, 03 01 07 does,
+  //   which is why readers check the length against the record type)
+  for (size_t length = 0; length < frame.size(); length++) {
+    TEST_ASSERT_TRUE(decode(frame.substr(0, length), decoded, sizeof(decoded)) < sizeof(record));
+  }
+  // too long for the caller
+  TEST_ASSERT_EQUAL(0, decode(frame, decoded, sizeof(record) - 1));
+}
+
+void test_reader_resynchronises(void) {
+  TelemetryTickRecord first = tickRecord(1);
+  TelemetryTickRecord second = tickRecord(2);
+  Telemetry::tick(first);
+  Telemetry::tick(second);
+  std::vector<std::string> frames = sentFrames();
+  TEST_ASSERT_EQUAL(2, frames.size());
+
+  // the reader came in partway through the first frame
+  uint8_t decoded[telemetryMaxRecord];
+  TEST_ASSERT_EQUAL(0, decode(frames[0].substr(5), decoded, sizeof(decoded)));
+  TEST_ASSERT_EQUAL(sizeof(second), decode(frames[1], decoded, sizeof(decoded)));
+  TEST_ASSERT_EQUAL_MEMORY(&second, decoded, sizeof(second));
+}
+
+void test_full_queue_drops_and_reports(void) {
+  TelemetryTickRecord record = tickRecord(0);
+  uint16_t queued = 0;
+  while (Telemetry::tick(record)) {
+    record = tickRecord(++queued);
+  }
+  TEST_ASSERT_EQUAL(telemetryBufferSize / (sizeof(record) + 3), queued); // whole 14 byte frames
+  TEST_ASSERT_FALSE(Telemetry::tick(record));
+  TEST_ASSERT_EQUAL(2, Telemetry::dropped());
+
+  // what was queued went out whole
+  std::vector<std::string> frames = sentFrames();
+  TEST_ASSERT_EQUAL(queued, frames.size());
+  uint8_t decoded[telemetryMaxRecord];
+  for (uint16_t i = 0; i < queued; i++) {
+    TEST_ASSERT_EQUAL(sizeof(record), decode(frames[i], decoded, sizeof(decoded)));
+    TEST_ASSERT_EQUAL(i, ((TelemetryTickRecord *)decoded)->tickCount);
+  }
+
+  // the next frame is preceded by the report of the two lost
+  record = tickRecord(1000);
+  TEST_ASSERT_TRUE(Telemetry::tick(record));
+  frames = sentFrames();
+  TEST_ASSERT_EQUAL(2, frames.size());
+  TelemetryEventRecord report;
+  TEST_ASSERT_EQUAL(sizeof(report), decode(frames[0], (uint8_t *)&report, sizeof(report)));
+  TEST_ASSERT_EQUAL(TelemetryDropped, report.code);
+  TEST_ASSERT_EQUAL(2, report.value);
+  TEST_ASSERT_EQUAL(sizeof(record), decode(frames[1], decoded, sizeof(decoded)));
+  TEST_ASSERT_EQUAL(1000, ((TelemetryTickRecord *)decoded)->tickCount);
+  TEST_ASSERT_EQUAL(2, Telemetry::dropped());
+}
+
+void test_background_leaves_room_for_a_tick(void) {
+  TelemetryHistogramRecord histogram;
+  memset(&histogram, 0, sizeof(histogram));
+  histogram.type = TelemetryHistogram;
+  uint16_t queued = 0;
+  while (Telemetry::background(&histogram, sizeof(histogram))) {
+    queued++;
+  }
+  TEST_ASSERT_GREATER_THAN(0, queued);
+  TEST_ASSERT_EQUAL(0, Telemetry::dropped());
+
+  // a tick still fits, and goes out after them
+  TelemetryTickRecord record = tickRecord(5);
+  TEST_ASSERT_TRUE(Telemetry::tick(record));
+  std::vector<std::string> frames = sentFrames();
+  TEST_ASSERT_EQUAL(queued + 1, frames.size());
+  uint8_t decoded[telemetryMaxRecord];
+  TEST_ASSERT_EQUAL(sizeof(histogram), decode(frames[0], decoded, sizeof(decoded)));
+  TEST_ASSERT_EQUAL(TelemetryHistogram, decoded[0]);
+  TEST_ASSERT_EQUAL(sizeof(record), decode(frames[queued], decoded, sizeof(decoded)));
+
+  // and a drop report goes out before any more of them
+  while (Telemetry::tick(record)) {
+  }
+  sentFrames();
+  TEST_ASSERT_FALSE(Telemetry::background(&histogram, sizeof(histogram)));
+  TEST_ASSERT_TRUE(Telemetry::tick(record));
+  TEST_ASSERT_TRUE(Telemetry::background(&histogram, sizeof(histogram)));
+  TEST_ASSERT_EQUAL(1, Telemetry::dropped());
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_crc8_check_value);
+  RUN_TEST(test_tick_round_trips);
+  RUN_TEST(test_event_round_trips);
+  RUN_TEST(test_damaged_frames_are_rejected);
+  RUN_TEST(test_reader_resynchronises);
+  RUN_TEST(test_full_queue_drops_and_reports);
+  RUN_TEST(test_background_leaves_room_for_a_tick);
+  return UNITY_END();
+}
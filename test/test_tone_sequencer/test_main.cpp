@@ -0,0 +1,154 @@
+/*
+    test_main.cpp (test_tone_sequencer)
+    2026-10-17
+
+    ToneSequencer on the simulated clock, whose timer stands in for Timer0's compare B interrupt:
+        steps play in order, each ending on the first interrupt at or after the sum of the
+            durations so far, so rounding to whole interrupts never accumulates
+        a pattern stops after its repeats; a pattern of 0 repeats plays until stopped
+        stop() silences the buzzer and the interrupt; play() after it starts from the first step
+        play() preempts a pattern of the same or lower priority and is refused by a higher one
+
+    pio test -e native -f test_tone_sequencer
+*/
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include "sim_board.h"
+#include "tone_sequencer.h"
+
+const uint8_t buzzer = 8;
+
+const ToneStep chirpSteps[] PROGMEM = {{440, 100}, {0, 50}, {880, 200}};
+const TonePattern chirpTwice PROGMEM = {chirpSteps, 3, 2};
+const TonePattern chirpForever PROGMEM = {chirpSteps, 3, 0};
+
+const ToneStep beepSteps[] PROGMEM = {{2000, 30}};
+const TonePattern beepOnce PROGMEM = {beepSteps, 1, 1};
+
+static SimBoard *board;
+static SimBoard::Scope *scope;
+static unsigned long started;
+
+// when a step ending elapsedMillis into the pattern hands over: the first interrupt at or after it
+static unsigned long handOver(unsigned long elapsedMillis) {
+  unsigned long interrupts = (elapsedMillis * 1000 + toneSequencerTickMicros - 1) / toneSequencerTickMicros;
+  return started + interrupts * toneSequencerTickMicros;
+}
+
+static void runUntil(unsigned long micros) {
+  board->advanceMicros(micros - board->micros());
+}
+
+static void play(const TonePattern *pattern, uint8_t priority) {
+  TEST_ASSERT_TRUE(ToneSequencer::play(pattern, priority));
+  started = board->micros();
+}
+
+void setUp(void) {
+  board = new SimBoard();
+  scope = new SimBoard::Scope(*board);
+  board->advanceMicros(12345); // out of step with the interrupt's period
+  ToneSequencer::begin(buzzer);
+}
+
+void tearDown(void) {
+  ToneSequencer::stop();
+  delete scope;
+  delete board;
+}
+
+void test_steps_follow_the_interrupt(void) {
+  play(&chirpTwice, 1);
+  TEST_ASSERT_EQUAL(440, board->toneFrequency(buzzer));
+
+  const unsigned int frequencies[] = {440, 0, 880, 440, 0, 880};
+  const unsigned long durations[] = {100, 50, 200, 100, 50, 200};
+  unsigned long elapsed = 0;
+  for (uint8_t step = 0; step < 6; step++) {
+    elapsed += durations[step];
+    runUntil(handOver(elapsed) - 1);
+    TEST_ASSERT_EQUAL(frequencies[step], board->toneFrequency(buzzer));
+    TEST_ASSERT_TRUE(ToneSequencer::isPlaying());
+    runUntil(handOver(elapsed));
+    if (step < 5) {
+      TEST_ASSERT_EQUAL(frequencies[step + 1], board->toneFrequency(buzzer));
+    }
+  }
+  // 700ms of steps end within one interrupt of 700ms
+  TEST_ASSERT_TRUE(handOver(700) - started - 700000 < toneSequencerTickMicros);
+
+  TEST_ASSERT_FALSE(ToneSequencer::isPlaying());
+  TEST_ASSERT_EQUAL(0, board->toneFrequency(buzzer));
+  TEST_ASSERT_EQUAL(0, ToneSequencer::priority());
+  unsigned long tones = board->toneCount();
+  board->advanceMillis(1000); // the interrupt is off: nothing more happens
+  TEST_ASSERT_EQUAL(tones, board->toneCount());
+}
+
+void test_no_repeats_plays_until_stopped(void) {
+  play(&chirpForever, 1);
+  unsigned long cycles = 30; // 10.5s
+  runUntil(handOver(cycles * 350 + 100 + 50) + 1);
+  TEST_ASSERT_TRUE(ToneSequencer::isPlaying());
+  TEST_ASSERT_EQUAL(880, board->toneFrequency(buzzer));
+  runUntil(handOver((cycles + 1) * 350) + 1);
+  TEST_ASSERT_EQUAL(440, board->toneFrequency(buzzer));
+
+  ToneSequencer::stop();
+  TEST_ASSERT_FALSE(ToneSequencer::isPlaying());
+  TEST_ASSERT_EQUAL(0, board->toneFrequency(buzzer));
+  unsigned long tones = board->toneCount();
+  board->advanceMillis(1000);
+  TEST_ASSERT_EQUAL(tones, board->toneCount());
+}
+
+void test_restart_starts_from_the_first_step(void) {
+  play(&chirpTwice, 1);
+  runUntil(handOver(100 + 50 + 20)); // into the 880Hz step
+  TEST_ASSERT_EQUAL(880, board->toneFrequency(buzzer));
+  ToneSequencer::stop();
+  board->advanceMillis(333);
+
+  play(&chirpTwice, 1);
+  TEST_ASSERT_EQUAL(440, board->toneFrequency(buzzer));
+  runUntil(handOver(100) - 1); // timed from the restart, with nothing left over from before
+  TEST_ASSERT_EQUAL(440, board->toneFrequency(buzzer));
+  runUntil(handOver(100));
+  TEST_ASSERT_EQUAL(0, board->toneFrequency(buzzer));
+  runUntil(handOver(700));
+  TEST_ASSERT_FALSE(ToneSequencer::isPlaying());
+}
+
+void test_priority_and_preemption(void) {
+  play(&chirpForever, 2);
+  TEST_ASSERT_EQUAL(2, ToneSequencer::priority());
+  TEST_ASSERT_FALSE(ToneSequencer::play(&beepOnce, 1)); // lower: refused, the chirp carries on
+  TEST_ASSERT_EQUAL(440, board->toneFrequency(buzzer));
+  TEST_ASSERT_EQUAL(2, ToneSequencer::priority());
+
+  play(&beepOnce, 2); // the same priority cuts the chirp off
+  TEST_ASSERT_EQUAL(2000, board->toneFrequency(buzzer));
+  runUntil(handOver(30) - 1);
+  TEST_ASSERT_EQUAL(2000, board->toneFrequency(buzzer));
+  runUntil(handOver(30));
+  TEST_ASSERT_FALSE(ToneSequencer::isPlaying()); // the chirp does not come back
+  TEST_ASSERT_EQUAL(0, board->toneFrequency(buzzer));
+
+  play(&beepOnce, 0); // finished: free for any priority
+  TEST_ASSERT_EQUAL(0, ToneSequencer::priority());
+  TEST_ASSERT_TRUE(ToneSequencer::isPlaying());
+  play(&chirpTwice, 3);
+  TEST_ASSERT_EQUAL(3, ToneSequencer::priority());
+  TEST_ASSERT_EQUAL(440, board->toneFrequency(buzzer));
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_steps_follow_the_interrupt);
+  RUN_TEST(test_no_repeats_plays_until_stopped);
+  RUN_TEST(test_restart_starts_from_the_first_step);
+  RUN_TEST(test_priority_and_preemption);
+  return UNITY_END();
+}
@@ -0,0 +1,145 @@
+/*
+    test_main.cpp (test_unlock)
+    2026-10-17
+
+    PIN entry (see Dwelling::unlock() and interrupt_keypad.h), typed on the simulated keypad
+        between the dwelling's 100ms ticks:
+        taps shorter than a tick, two taps within one tick, a key held across two ticks and short
+            release to press gaps each count exactly once
+        three bad codes lock the panel out; keys typed during the lockout are dropped, and the
+            right code unlocks once it has been served
+
+    pio test -e native -f test_unlock
+*/
+
+#include <Arduino.h>
+#include <string.h>
+#include <unity.h>
+
+#include "dwelling.h"
+#include "native/dwelling_rig.h"
+#include "sim_board.h"
+
+const unsigned long tickMillis = 100;
+
+static SimBoard *board;
+static SimBoard::Scope *scope;
+static DwellingRig *rig;
+static Dwelling *dwelling;
+static int ticks;
+static unsigned long nextTick;
+
+// move time on a millisecond at a time, ticking the dwelling every tickMillis as the main loop would
+static void run(unsigned long millis) {
+  for (unsigned long i = 0; i < millis; i++) {
+    board->advanceMillis(1);
+    if ((long)(board->millis() - nextTick) >= 0) {
+      dwelling->tick(++ticks);
+      nextTick += tickMillis;
+    }
+  }
+}
+
+static void tap(char key, unsigned long heldMillis, unsigned long gapMillis) {
+  TEST_ASSERT_TRUE(rig->keypad.press(key));
+  run(heldMillis);
+  TEST_ASSERT_TRUE(rig->keypad.release(key));
+  run(gapMillis);
+}
+
+static void typeCode(const char *keys, unsigned long heldMillis, unsigned long gapMillis) {
+  for (const char *key = keys; *key; key++) {
+    tap(*key, heldMillis, gapMillis);
+  }
+}
+
+static bool lcdShows(uint8_t row, const char *text) {
+  return rig->lcd.text(row).compare(0, strlen(text), text) == 0;
+}
+
+static void waitForPrompt(void) {
+  for (int i = 0; i < 300 && !lcdShows(0, "Input PIN:     "); i++) {
+    run(tickMillis);
+  }
+  TEST_ASSERT_TRUE(lcdShows(0, "Input PIN:     "));
+}
+
+void setUp(void) {
+  board = new SimBoard();
+  scope = new SimBoard::Scope(*board);
+  rig = new DwellingRig(*board);
+  dwelling = new Dwelling();
+  dwelling->init();
+  ticks = 0;
+  nextTick = board->millis() + tickMillis;
+  waitForPrompt();
+}
+
+void tearDown(void) {
+  delete dwelling;
+  delete rig;
+  delete scope;
+  delete board;
+}
+
+void test_sub_tick_taps_unlock(void) {
+  run(30); // out of step with the ticks
+  typeCode(unlockCode, 60, 40);
+  run(tickMillis);
+  TEST_ASSERT_TRUE(dwelling->isUnlocked());
+  TEST_ASSERT_TRUE(lcdShows(0, "System Unlocked"));
+}
+
+void test_each_press_counts_once(void) {
+  run(10);
+  tap(unlockCode[0], 20, 15); // two whole taps inside one tick
+  tap(unlockCode[1], 20, 15);
+  run(tickMillis);
+  TEST_ASSERT_TRUE(lcdShows(0, "Input PIN:**    "));
+
+  tap(unlockCode[2], 250, 5); // held across two ticks, then pressed again straight away
+  tap(unlockCode[3], 250, 5);
+  run(tickMillis);
+  TEST_ASSERT_TRUE(lcdShows(0, "Input PIN:****  "));
+
+  tap(unlockCode[4], 40, 20);
+  tap(unlockCode[5], 40, 20);
+  run(tickMillis);
+  TEST_ASSERT_TRUE(dwelling->isUnlocked());
+}
+
+void test_bad_codes_lock_out(void) {
+  typeCode("111111", 50, 30);
+  run(tickMillis);
+  TEST_ASSERT_TRUE(lcdShows(0, "Bad Code: 1"));
+  TEST_ASSERT_TRUE(lcdShows(1, "Try Again"));
+  typeCode("123", 50, 30); // dropped while the message is up
+  run(5000);
+  waitForPrompt();
+
+  typeCode("222222", 50, 30);
+  run(5000 + tickMillis);
+  waitForPrompt();
+  typeCode("333333", 50, 30);
+  run(tickMillis);
+  TEST_ASSERT_TRUE(lcdShows(0, "There Will Be A"));
+  TEST_ASSERT_TRUE(lcdShows(1, "15 Second Delay"));
+
+  typeCode(unlockCode, 50, 30); // dropped: the lockout has to be served
+  TEST_ASSERT_FALSE(dwelling->isUnlocked());
+  run(15000 - 6 * 80);
+  waitForPrompt();
+  TEST_ASSERT_TRUE(lcdShows(0, "Input PIN:     "));
+
+  typeCode(unlockCode, 50, 30);
+  run(tickMillis);
+  TEST_ASSERT_TRUE(dwelling->isUnlocked());
+}
+
+int main(int argc, char **argv) {
+  UNITY_BEGIN();
+  RUN_TEST(test_sub_tick_taps_unlock);
+  RUN_TEST(test_each_press_counts_once);
+  RUN_TEST(test_bad_codes_lock_out);
+  return UNITY_END();
+}